@@ -10,7 +10,24 @@
 #define _INCLUDE_AEX_ARDUINO_EXTRA_H_
 
 #include "ArduinoExtra/Functional.h"
+#include "ArduinoExtra/FunctionRef.h"
 #include "ArduinoExtra/Array.h"
+#include "ArduinoExtra/FlashArray.h"
+#include "ArduinoExtra/Span.h"
 #include "ArduinoExtra/Vector.h"
+#include "ArduinoExtra/StaticVector.h"
+#include "ArduinoExtra/SmallVector.h"
+#include "ArduinoExtra/RingBuffer.h"
+#include "ArduinoExtra/StaticHashMap.h"
+#include "ArduinoExtra/HashMap.h"
+#include "ArduinoExtra/IntrusiveList.h"
+#include "ArduinoExtra/Algorithm.h"
+#include "ArduinoExtra/Fixed.h"
+#include "ArduinoExtra/Numeric.h"
+#include "ArduinoExtra/Pool.h"
+#include "ArduinoExtra/Event.h"
+#include "ArduinoExtra/DeferredQueue.h"
+#include "ArduinoExtra/Profiler.h"
+#include "ArduinoExtra/Scheduler.h"
 
 #endif // _INCLUDE_AEX_ARDUINO_EXTRA_H_
@@ -0,0 +1,843 @@
+/**
+ * @file Algorithm.h
+ * @author Eliot Fondere
+ * @brief In-place algorithms (sort, median, binary search, etc.) that never allocate memory
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Every algorithm takes a range of elements as two pointers (first element and past the last
+ * element) or directly a container with begin() and end() (Array, Vector, StaticVector, etc.).
+ * Comparators and operations are template parameters so they can be inlined: lambdas, functors,
+ * function pointers and FunctionRef are all accepted. None of the algorithms are recursive.
+ *
+ * Example Usage:
+ * @code
+ * aex::Array<int, 5> readings = {{ 512, 498, 1023, 505, 501 }};
+ *
+ * int filtered = aex::median(readings); // 505, the readings are reordered
+ *
+ * aex::sort(readings); // 498 501 505 512 1023
+ * aex::sort(readings, [](int a, int b) -> bool { return a > b; }); // 1023 512 505 501 498
+ *
+ * long total = aex::accumulate(readings, 0L); // 3039
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_ALGORITHM_H_
+#define _INCLUDE_AEX_ALGORITHM_H_
+
+#include "utils.h"
+
+namespace aex
+{
+
+namespace priv
+{
+
+/**
+ * @brief Default comparator of the algorithms (uses the < operator)
+ */
+struct Less
+{
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const
+    {
+        return a < b;
+    }
+};
+
+/**
+ * @brief Default operation of accumulate() (uses the + operator)
+ */
+struct Plus
+{
+    template<typename A, typename B>
+    A operator()(const A& a, const B& b) const
+    {
+        return a + b;
+    }
+};
+
+/// Ranges up to this size are sorted with insertion sort (faster than heapsort for few elements)
+const size_t INSERTION_SORT_THRESHOLD = 16;
+
+/**
+ * @brief Sort a range with insertion sort (stable, fast for small or almost sorted ranges)
+ *
+ * @tparam T type of the elements
+ * @tparam Compare type of the comparator
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ */
+template<typename T, typename Compare>
+void insertionSort(T* first, T* last, Compare& compare)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    for (T* i = first + 1; i < last; i++)
+    {
+        if (!compare(*i, *(i - 1)))
+        {
+            continue;
+        }
+
+        // shift the bigger elements to the right instead of swapping them one by one
+        T value(move(*i));
+        T* hole = i;
+
+        do
+        {
+            *hole = move(*(hole - 1));
+            hole--;
+        } while (hole > first && compare(value, *(hole - 1)));
+
+        *hole = move(value);
+    }
+}
+
+/**
+ * @brief Move an element down a max-heap until its children are not bigger
+ *
+ * @tparam T type of the elements
+ * @tparam Compare type of the comparator
+ * @param heap pointer to the first element of the heap
+ * @param index index of the element to move
+ * @param size number of elements in the heap
+ * @param compare returns true if its first argument goes before the second
+ */
+template<typename T, typename Compare>
+void siftDown(T* heap, size_t index, size_t size, Compare& compare)
+{
+    T value(move(heap[index]));
+
+    while (2 * index + 1 < size)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child + 1 < size && compare(heap[child], heap[child + 1]))
+        {
+            child++;
+        }
+
+        if (!compare(value, heap[child]))
+        {
+            break;
+        }
+
+        heap[index] = move(heap[child]);
+        index = child;
+    }
+
+    heap[index] = move(value);
+}
+
+/**
+ * @brief Sort a range with heapsort (O(n log n) in every case, no extra memory)
+ *
+ * @tparam T type of the elements
+ * @tparam Compare type of the comparator
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ */
+template<typename T, typename Compare>
+void heapSort(T* first, T* last, Compare& compare)
+{
+    size_t size = last - first;
+
+    for (size_t i = size / 2; i > 0; i--)
+    {
+        siftDown(first, i - 1, size, compare);
+    }
+
+    while (size > 1)
+    {
+        size--;
+        swap(first[0], first[size]);
+        siftDown(first, 0, size, compare);
+    }
+}
+
+/**
+ * @brief Put three elements in order
+ *
+ * @tparam T type of the elements
+ * @tparam Compare type of the comparator
+ * @param a element that ends up the smallest
+ * @param b element that ends up the median
+ * @param c element that ends up the biggest
+ * @param compare returns true if its first argument goes before the second
+ */
+template<typename T, typename Compare>
+void sortThree(T& a, T& b, T& c, Compare& compare)
+{
+    if (compare(b, a))
+    {
+        swap(a, b);
+    }
+
+    if (compare(c, b))
+    {
+        swap(b, c);
+
+        if (compare(b, a))
+        {
+            swap(a, b);
+        }
+    }
+}
+
+} // namespace priv
+
+/**
+ * @brief Sort a range in place (not stable)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ *
+ * Uses insertion sort for small ranges and heapsort otherwise: no recursion and no allocation.
+ */
+template<typename T, typename Compare>
+void sort(T* first, T* last, Compare compare)
+{
+    if (static_cast<size_t>(last - first) <= priv::INSERTION_SORT_THRESHOLD)
+    {
+        priv::insertionSort(first, last, compare);
+    }
+    else
+    {
+        priv::heapSort(first, last, compare);
+    }
+}
+
+/**
+ * @brief Sort a range in place in ascending order (not stable)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ */
+template<typename T>
+void sort(T* first, T* last)
+{
+    sort(first, last, priv::Less());
+}
+
+/**
+ * @brief Check if a range is sorted
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ * @return true the range is sorted
+ * @return false at least one element is out of order
+ */
+template<typename T, typename Compare>
+bool isSorted(const T* first, const T* last, Compare compare)
+{
+    for (const T* i = first + 1; i < last; i++)
+    {
+        if (compare(*i, *(i - 1)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check if a range is sorted in ascending order
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @return true the range is sorted
+ * @return false at least one element is out of order
+ */
+template<typename T>
+bool isSorted(const T* first, const T* last)
+{
+    return isSorted(first, last, priv::Less());
+}
+
+/**
+ * @brief Partially sort a range so that a given element is where it would be if sorted
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param nth pointer to the element to put in place
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ *
+ * Afterwards, no element before nth goes after it and no element after nth goes before it.
+ * Uses an iterative quickselect (O(n) on average) finished by insertion sort.
+ */
+template<typename T, typename Compare>
+void nthElement(T* first, T* nth, T* last, Compare compare)
+{
+    if (nth >= last)
+    {
+        return;
+    }
+
+    while (static_cast<size_t>(last - first) > priv::INSERTION_SORT_THRESHOLD)
+    {
+        // median of three as the pivot, which also stops both scans below at the ends of the range
+        T* middle = first + (last - first - 1) / 2;
+        priv::sortThree(*first, *middle, *(last - 1), compare);
+        T pivot(*middle);
+
+        // Hoare partition: handles many equal elements (common with sensor readings) well
+        T* i = first;
+        T* j = last - 1;
+
+        while (true)
+        {
+            while (compare(*i, pivot))
+            {
+                i++;
+            }
+
+            while (compare(pivot, *j))
+            {
+                j--;
+            }
+
+            if (i >= j)
+            {
+                break;
+            }
+
+            swap(*i, *j);
+            i++;
+            j--;
+        }
+
+        // [first, j] are not after the pivot and [j + 1, last) are not before it
+        if (nth <= j)
+        {
+            last = j + 1;
+        }
+        else
+        {
+            first = j + 1;
+        }
+    }
+
+    priv::insertionSort(first, last, compare);
+}
+
+/**
+ * @brief Partially sort a range so that a given element is where it would be if sorted in
+ * ascending order
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param nth pointer to the element to put in place
+ * @param last pointer past the last element
+ */
+template<typename T>
+void nthElement(T* first, T* nth, T* last)
+{
+    nthElement(first, nth, last, priv::Less());
+}
+
+/**
+ * @brief Find the median of a range (reorders the elements)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element (the range must not be empty)
+ * @param compare returns true if its first argument goes before the second
+ * @return T& reference to the median element (the upper one for an even number of elements)
+ */
+template<typename T, typename Compare>
+T& median(T* first, T* last, Compare compare)
+{
+    T* middle = first + (last - first) / 2;
+    nthElement(first, middle, last, compare);
+    return *middle;
+}
+
+/**
+ * @brief Find the median of a range (reorders the elements)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element (the range must not be empty)
+ * @return T& reference to the median element (the upper one for an even number of elements)
+ */
+template<typename T>
+T& median(T* first, T* last)
+{
+    return median(first, last, priv::Less());
+}
+
+/**
+ * @brief Find the first element of a sorted range that does not go before a value
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @param compare returns true if its first argument goes before the second (same as for sorting)
+ * @return T* pointer to the element, last if all the elements go before the value
+ */
+template<typename T, typename V, typename Compare>
+T* lowerBound(T* first, T* last, const V& value, Compare compare)
+{
+    size_t count = last - first;
+
+    while (count > 0)
+    {
+        size_t half = count / 2;
+
+        if (compare(first[half], value))
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Find the first element of a range sorted in ascending order that is not less than a value
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @return T* pointer to the element, last if all the elements are less than the value
+ */
+template<typename T, typename V>
+T* lowerBound(T* first, T* last, const V& value)
+{
+    return lowerBound(first, last, value, priv::Less());
+}
+
+/**
+ * @brief Find the first element of a sorted range that goes after a value
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @param compare returns true if its first argument goes before the second (same as for sorting)
+ * @return T* pointer to the element, last if no element goes after the value
+ */
+template<typename T, typename V, typename Compare>
+T* upperBound(T* first, T* last, const V& value, Compare compare)
+{
+    size_t count = last - first;
+
+    while (count > 0)
+    {
+        size_t half = count / 2;
+
+        if (!compare(value, first[half]))
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+/**
+ * @brief Find the first element of a range sorted in ascending order that is greater than a value
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @return T* pointer to the element, last if no element is greater than the value
+ */
+template<typename T, typename V>
+T* upperBound(T* first, T* last, const V& value)
+{
+    return upperBound(first, last, value, priv::Less());
+}
+
+/**
+ * @brief Find an element equivalent to a value in a sorted range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @param compare returns true if its first argument goes before the second (same as for sorting)
+ * @return T* pointer to the element, nullptr if there is none
+ */
+template<typename T, typename V, typename Compare>
+T* binarySearch(T* first, T* last, const V& value, Compare compare)
+{
+    T* found = lowerBound(first, last, value, compare);
+    return (found != last && !compare(value, *found)) ? found : nullptr;
+}
+
+/**
+ * @brief Find an element equal to a value in a range sorted in ascending order
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @return T* pointer to the element, nullptr if there is none
+ */
+template<typename T, typename V>
+T* binarySearch(T* first, T* last, const V& value)
+{
+    return binarySearch(first, last, value, priv::Less());
+}
+
+/**
+ * @brief Combine all the elements of a range (e.g. sum them)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam R type of the result (no need to manually type)
+ * @tparam Operation type of the operation (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param initial initial value of the result (also gives its type, e.g. 0L to sum ints into a long)
+ * @param operation returns the combination of the result so far (first argument) and an element
+ * @return R the result
+ */
+template<typename T, typename R, typename Operation>
+R accumulate(const T* first, const T* last, R initial, Operation operation)
+{
+    for (; first < last; first++)
+    {
+        initial = operation(initial, *first);
+    }
+
+    return initial;
+}
+
+/**
+ * @brief Sum all the elements of a range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam R type of the result (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param initial initial value of the sum (also gives its type, e.g. 0L to sum ints into a long)
+ * @return R the sum
+ */
+template<typename T, typename R>
+R accumulate(const T* first, const T* last, R initial)
+{
+    return accumulate(first, last, initial, priv::Plus());
+}
+
+/**
+ * @brief Apply an operation to all the elements of a range and store the results
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam U type of the results (no need to manually type)
+ * @tparam Operation type of the operation (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param result pointer to where the first result is stored (can be first to modify in place)
+ * @param operation returns the result for an element
+ * @return U* pointer past the last result
+ */
+template<typename T, typename U, typename Operation>
+U* transform(const T* first, const T* last, U* result, Operation operation)
+{
+    for (; first < last; first++, result++)
+    {
+        *result = operation(*first);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Find the first element of a range equal to a value
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam V type of the value (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param value value to look for
+ * @return T* pointer to the element, nullptr if there is none
+ */
+template<typename T, typename V>
+T* find(T* first, T* last, const V& value)
+{
+    for (; first < last; first++)
+    {
+        if (*first == value)
+        {
+            return first;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Find the first element of a range matching a condition
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Predicate type of the condition (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param predicate returns true for the element to find
+ * @return T* pointer to the element, nullptr if there is none
+ */
+template<typename T, typename Predicate>
+T* findIf(T* first, T* last, Predicate predicate)
+{
+    for (; first < last; first++)
+    {
+        if (predicate(*first))
+        {
+            return first;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Find the smallest element of a range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ * @return T* pointer to the first smallest element, nullptr if the range is empty
+ */
+template<typename T, typename Compare>
+T* minElement(T* first, T* last, Compare compare)
+{
+    if (first >= last)
+    {
+        return nullptr;
+    }
+
+    T* smallest = first;
+
+    for (first++; first < last; first++)
+    {
+        if (compare(*first, *smallest))
+        {
+            smallest = first;
+        }
+    }
+
+    return smallest;
+}
+
+/**
+ * @brief Find the smallest element of a range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @return T* pointer to the first smallest element, nullptr if the range is empty
+ */
+template<typename T>
+T* minElement(T* first, T* last)
+{
+    return minElement(first, last, priv::Less());
+}
+
+/**
+ * @brief Find the biggest element of a range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam Compare type of the comparator (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @param compare returns true if its first argument goes before the second
+ * @return T* pointer to the first biggest element, nullptr if the range is empty
+ */
+template<typename T, typename Compare>
+T* maxElement(T* first, T* last, Compare compare)
+{
+    if (first >= last)
+    {
+        return nullptr;
+    }
+
+    T* biggest = first;
+
+    for (first++; first < last; first++)
+    {
+        if (compare(*biggest, *first))
+        {
+            biggest = first;
+        }
+    }
+
+    return biggest;
+}
+
+/**
+ * @brief Find the biggest element of a range
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @param first pointer to the first element
+ * @param last pointer past the last element
+ * @return T* pointer to the first biggest element, nullptr if the range is empty
+ */
+template<typename T>
+T* maxElement(T* first, T* last)
+{
+    return maxElement(first, last, priv::Less());
+}
+
+/*
+ * Container versions of the algorithms above, for anything with begin() and end() returning
+ * pointers (Array, Vector, SmallVector, StaticVector). The trailing return types only keep them
+ * from being picked for pointers.
+ */
+
+/**
+ * @brief Sort a container in place (see sort(T*, T*, Compare))
+ */
+template<typename C, typename Compare>
+auto sort(C& container, Compare compare) -> decltype(container.begin(), void())
+{
+    sort(container.begin(), container.end(), compare);
+}
+
+/**
+ * @brief Sort a container in place in ascending order (see sort(T*, T*))
+ */
+template<typename C>
+auto sort(C& container) -> decltype(container.begin(), void())
+{
+    sort(container.begin(), container.end());
+}
+
+/**
+ * @brief Check if a container is sorted in ascending order (see isSorted(const T*, const T*))
+ */
+template<typename C>
+auto isSorted(const C& container) -> decltype(container.begin(), bool())
+{
+    return isSorted(container.begin(), container.end());
+}
+
+/**
+ * @brief Put the element at a given index where it would be if the container was sorted (see
+ * nthElement(T*, T*, T*))
+ */
+template<typename C>
+auto nthElement(C& container, size_t index) -> decltype(container.begin(), void())
+{
+    nthElement(container.begin(), container.begin() + index, container.end());
+}
+
+/**
+ * @brief Find the median of a container, reordering its elements (see median(T*, T*))
+ */
+template<typename C>
+auto median(C& container) -> decltype(*container.begin())
+{
+    return median(container.begin(), container.end());
+}
+
+/**
+ * @brief Find the first element not less than a value in a sorted container (see
+ * lowerBound(T*, T*, const V&))
+ */
+template<typename C, typename V>
+auto lowerBound(C& container, const V& value) -> decltype(container.begin())
+{
+    return lowerBound(container.begin(), container.end(), value);
+}
+
+/**
+ * @brief Find an element equal to a value in a sorted container (see binarySearch(T*, T*, const V&))
+ */
+template<typename C, typename V>
+auto binarySearch(C& container, const V& value) -> decltype(container.begin())
+{
+    return binarySearch(container.begin(), container.end(), value);
+}
+
+/**
+ * @brief Sum all the elements of a container (see accumulate(const T*, const T*, R))
+ */
+template<typename C, typename R>
+auto accumulate(const C& container, R initial) -> decltype(container.begin(), R())
+{
+    return accumulate(container.begin(), container.end(), initial);
+}
+
+/**
+ * @brief Combine all the elements of a container (see accumulate(const T*, const T*, R, Operation))
+ */
+template<typename C, typename R, typename Operation>
+auto accumulate(const C& container, R initial, Operation operation) -> decltype(container.begin(), R())
+{
+    return accumulate(container.begin(), container.end(), initial, operation);
+}
+
+/**
+ * @brief Find the first element of a container equal to a value (see find(T*, T*, const V&))
+ */
+template<typename C, typename V>
+auto find(C& container, const V& value) -> decltype(container.begin())
+{
+    return find(container.begin(), container.end(), value);
+}
+
+/**
+ * @brief Find the smallest element of a container (see minElement(T*, T*))
+ */
+template<typename C>
+auto minElement(C& container) -> decltype(container.begin())
+{
+    return minElement(container.begin(), container.end());
+}
+
+/**
+ * @brief Find the biggest element of a container (see maxElement(T*, T*))
+ */
+template<typename C>
+auto maxElement(C& container) -> decltype(container.begin())
+{
+    return maxElement(container.begin(), container.end());
+}
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_ALGORITHM_H_
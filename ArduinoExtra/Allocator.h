@@ -0,0 +1,223 @@
+/**
+ * @file Allocator.h
+ * @author Eliot Fondere
+ * @brief Default memory allocator used by the containers and Function
+ * 
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ * 
+ * An allocator is a type with two static functions:
+ * - void* allocate(size_t size): get a block of at least size bytes (nullptr on failure)
+ * - void deallocate(void* ptr, size_t size): free a block returned by allocate()
+ * 
+ * It is passed as a template parameter (e.g. Vector<int, GrowthDouble, MyAllocator>) so using a
+ * custom allocator costs no memory in the containers themselves.
+ * 
+ * When AEX_TRACK_ALLOCATIONS is defined before including the library, HeapAllocator counts every
+ * allocation made by the library (vector growth, Function callables too large for their buffer,
+ * hash maps...) so reserve() sizes and pools can be chosen from real data. Otherwise the tracking
+ * and the macros below compile to nothing.
+ * 
+ * Example Usage:
+ * @code
+ * #define AEX_TRACK_ALLOCATIONS
+ * #include <ArduinoExtra.h>
+ * 
+ * void loop()
+ * {
+ *     // ...
+ *     AEX_ALLOCATIONS_DUMP(Serial); // allocations, frees, failures, live and peak bytes
+ * }
+ * @endcode
+ * 
+ * @see Pool.h for a fixed-block allocator
+ */
+
+#ifndef _INCLUDE_AEX_ALLOCATOR_H_
+#define _INCLUDE_AEX_ALLOCATOR_H_
+
+#include <new>
+#include <stddef.h>
+
+namespace aex
+{
+
+#ifdef AEX_TRACK_ALLOCATIONS
+/**
+ * @brief Counters of the heap allocations made by the library
+ * 
+ */
+struct AllocationStats
+{
+    unsigned long allocations; ///< number of successful allocations
+    unsigned long frees;       ///< number of blocks freed
+    unsigned long failures;    ///< number of allocations that ran out of memory
+    size_t        liveBytes;   ///< bytes currently allocated
+    size_t        peakBytes;   ///< highest value of liveBytes (high-water mark)
+};
+
+/**
+ * @brief Keeps the allocation counters of HeapAllocator (only exists with AEX_TRACK_ALLOCATIONS)
+ * 
+ * Custom allocators can call recordAllocation() and recordFree() to be counted as well.
+ */
+class AllocationTracker
+{
+public:
+    /**
+     * @brief Get the current counters
+     * 
+     * @return const AllocationStats& reference to the counters
+     */
+    static const AllocationStats& getStats()
+    {
+        return getMutableStats();
+    }
+
+    /**
+     * @brief Count an allocation
+     * 
+     * @param ptr pointer returned by the allocation (nullptr counts as a failure)
+     * @param size size of the block in bytes
+     */
+    static void recordAllocation(const void* ptr, size_t size)
+    {
+        AllocationStats& stats = getMutableStats();
+
+        if (ptr == nullptr)
+        {
+            stats.failures++;
+            return;
+        }
+
+        stats.allocations++;
+        stats.liveBytes += size;
+
+        if (stats.liveBytes > stats.peakBytes)
+        {
+            stats.peakBytes = stats.liveBytes;
+        }
+    }
+
+    /**
+     * @brief Count a free
+     * 
+     * @param ptr pointer to the freed block (nothing is counted for nullptr)
+     * @param size size of the block in bytes
+     */
+    static void recordFree(const void* ptr, size_t size)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        AllocationStats& stats = getMutableStats();
+        stats.frees++;
+        stats.liveBytes -= size;
+    }
+
+    /**
+     * @brief Print the counters on two lines (names, then values)
+     * 
+     * @tparam P type of the printer (no need to manually type)
+     * @param printer where to print (e.g. Serial)
+     */
+    template<typename P>
+    static void dump(P& printer)
+    {
+        const AllocationStats& stats = getStats();
+
+        printer.println("allocations\tfrees\tfailures\tlive\tpeak");
+        printer.print(stats.allocations);
+        printer.print("\t");
+        printer.print(stats.frees);
+        printer.print("\t");
+        printer.print(stats.failures);
+        printer.print("\t");
+        printer.print(static_cast<unsigned long>(stats.liveBytes));
+        printer.print("\t");
+        printer.println(static_cast<unsigned long>(stats.peakBytes));
+    }
+
+    /**
+     * @brief Reset the counters (the live bytes are kept, the peak restarts from them)
+     * 
+     */
+    static void reset()
+    {
+        AllocationStats& stats = getMutableStats();
+        stats.allocations = 0;
+        stats.frees       = 0;
+        stats.failures    = 0;
+        stats.peakBytes   = stats.liveBytes;
+    }
+
+private:
+    /**
+     * @brief Get the counters of the program
+     * 
+     * @return AllocationStats& the only counters of the program (shared by all translation units)
+     */
+    static AllocationStats& getMutableStats()
+    {
+        static AllocationStats stats = {0, 0, 0, 0, 0};
+        return stats;
+    }
+};
+
+/**
+ * @brief Print the allocation counters
+ * 
+ * @param printer where to print (e.g. Serial)
+ */
+#define AEX_ALLOCATIONS_DUMP(printer) aex::AllocationTracker::dump(printer)
+
+/**
+ * @brief Reset the allocation counters
+ */
+#define AEX_ALLOCATIONS_RESET() aex::AllocationTracker::reset()
+#else
+#define AEX_ALLOCATIONS_DUMP(printer)
+#define AEX_ALLOCATIONS_RESET()
+#endif
+
+/**
+ * @brief Allocator using the global heap (::operator new and ::operator delete)
+ * 
+ */
+struct HeapAllocator
+{
+    /**
+     * @brief Allocate a block of memory on the heap
+     * 
+     * @param size size of the block in bytes
+     * @return void* pointer to the block
+     */
+    static void* allocate(size_t size)
+    {
+        void* ptr = ::operator new(size);
+#ifdef AEX_TRACK_ALLOCATIONS
+        AllocationTracker::recordAllocation(ptr, size);
+#endif
+        return ptr;
+    }
+
+    /**
+     * @brief Free a block of memory allocated by allocate()
+     * 
+     * @param ptr pointer to the block
+     * @param size size of the block in bytes (only used for tracking, sized delete is not part of C++11)
+     */
+    static void deallocate(void* ptr, size_t size)
+    {
+        (void)size;
+#ifdef AEX_TRACK_ALLOCATIONS
+        AllocationTracker::recordFree(ptr, size);
+#endif
+        ::operator delete(ptr);
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_ALLOCATOR_H_
@@ -9,6 +9,9 @@
 #ifndef _INCLUDE_AEX_ARRAY_H_
 #define _INCLUDE_AEX_ARRAY_H_
 
+#include "utils.h"
+#include "BoundsCheck.h"
+
 namespace aex
 {
 
@@ -25,11 +28,11 @@ public:
     /**
      * @brief Get the size of the array
      * 
-     * @return const size_t size of the array
+     * @return size_t size of the array
      * 
      * Note the array is always full so the size is also the maximum capacity
      */
-    const size_t getSize()
+    constexpr size_t getSize() const
     {
         return S;
     }
@@ -39,9 +42,9 @@ public:
      * 
      * @return const T& const reference to the first element (read only)
      */
-    const T& front() const
+    constexpr const T& front() const
     {
-        return data[0];
+        return m_data[0];
     }
 
     /**
@@ -49,9 +52,9 @@ public:
      * 
      * @return T& reference to the first element (write access)
      */
-    T& front()
+    AEX_CONSTEXPR14 T& front()
     {
-        return data[0];
+        return m_data[0];
     }
 
     /**
@@ -59,9 +62,9 @@ public:
      * 
      * @return const T& const reference to the last element (read only)
      */
-    const T& back() const
+    constexpr const T& back() const
     {
-        return data[S - 1];
+        return m_data[S - 1];
     }
     
     /**
@@ -69,9 +72,9 @@ public:
      * 
      * @return T& reference to the last element (write access)
      */
-    T& back()
+    AEX_CONSTEXPR14 T& back()
     {
-        return data[S - 1];
+        return m_data[S - 1];
     }
 
     /**
@@ -80,17 +83,12 @@ public:
      * @param index index or position of the element
      * @return const T& const reference to the element at the given position (read only)
      * 
-     * Note: using at() instead of the [] operator checks if the index is out of bounds. However,
-     * in this implementation, there is no proper way to check for errors so this is not fully implemented
+     * Note: using at() instead of the [] operator checks if the index is out of bounds according
+     * to AEX_BOUNDS_CHECK (see BoundsCheck.h)
      */
-    const T& at(size_t index) const
+    constexpr const T& at(size_t index) const
     {
-        if (index >= S)
-        {
-            // error
-        }
-
-        return data[index];
+        return m_data[priv::checkIndex(index, S)];
     }
 
     /**
@@ -99,17 +97,12 @@ public:
      * @param index index or position of the element
      * @return T& reference to the element at a given position (write access)
      * 
-     * Note: using at() instead of the [] operator checks if the index is out of bounds. However,
-     * in this implementation, there is no proper way to check for errors so this is not fully implemented
+     * Note: using at() instead of the [] operator checks if the index is out of bounds according
+     * to AEX_BOUNDS_CHECK (see BoundsCheck.h)
      */
-    T& at(size_t index)
+    AEX_CONSTEXPR14 T& at(size_t index)
     {
-        if (index >= S)
-        {
-            // error
-        }
-
-        return data[index];
+        return m_data[priv::checkIndex(index, S)];
     }
 
     /**
@@ -120,9 +113,9 @@ public:
      * 
      * Note: no checks are perforemed to see if the index is out of bounds
      */
-    const T& operator[](size_t index) const
+    constexpr const T& operator[](size_t index) const
     {
-        return data[index];
+        return m_data[index];
     }
 
     /**
@@ -133,12 +126,131 @@ public:
      * 
      * Note: no checks are perforemed to see if the index is out of bounds
      */
-    T& operator[](size_t index)
+    AEX_CONSTEXPR14 T& operator[](size_t index)
+    {
+        return m_data[index];
+    }
+
+    /**
+     * @brief Get a pointer to the elements of the array
+     * 
+     * @return T* pointer to the first element
+     */
+    AEX_CONSTEXPR14 T* data()
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get a pointer to the elements of the array
+     * 
+     * @return const T* pointer to the first element (read only)
+     */
+    constexpr const T* data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     * 
+     * @return T* pointer to the first element
+     */
+    AEX_CONSTEXPR14 T* begin()
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     * 
+     * @return const T* pointer to the first element (read only)
+     */
+    constexpr const T* begin() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     * 
+     * @return T* pointer past the last element
+     */
+    AEX_CONSTEXPR14 T* end()
     {
-        return data[index];
+        return m_data + S;
     }
 
-    T data[S];  ///< actual data contained in the array
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     * 
+     * @return const T* pointer past the last element (read only)
+     */
+    constexpr const T* end() const
+    {
+        return m_data + S;
+    }
+
+    /**
+     * @brief Set all the elements of the array to the same value
+     * 
+     * @param value value copied into every element
+     */
+    AEX_CONSTEXPR14 void fill(const T& value)
+    {
+        for (size_t i = 0; i < S; i++)
+        {
+            m_data[i] = value;
+        }
+    }
+
+    /**
+     * @brief Create an array whose elements are computed from their index (at compile time if
+     * possible)
+     * 
+     * @tparam Generator type of the generator (no need to manually type)
+     * @param generator constexpr function or functor with a constexpr operator(), called with the
+     * index of every element
+     * @return Array the new array
+     * 
+     * Note: lambdas can only be used at compile time since C++17, use a functor instead.
+     * 
+     * Example Usage:
+     * @code
+     * struct Squares
+     * {
+     *     constexpr uint16_t operator()(size_t index) const
+     *     {
+     *         return index * index;
+     *     }
+     * };
+     * 
+     * constexpr aex::Array<uint16_t, 16> squares = aex::Array<uint16_t, 16>::generate(Squares());
+     * static_assert(squares[3] == 9, "computed at compile time");
+     * @endcode
+     */
+    template<typename Generator>
+    static constexpr Array generate(const Generator& generator)
+    {
+        return generate(generator, make_index_sequence<S>());
+    }
+
+    T m_data[S];  ///< actual data contained in the array (public so the array can be initialized like a C array, was named data before data() was added, see README)
+
+private:
+    /**
+     * @brief Create an array by calling a generator with every index
+     * 
+     * @tparam Generator type of the generator
+     * @tparam I indices of the elements
+     * @param generator function called with every index
+     * @return Array the new array
+     */
+    template<typename Generator, size_t... I>
+    static constexpr Array generate(const Generator& generator, index_sequence<I...>)
+    {
+        return Array{{ static_cast<T>(generator(I))... }};
+    }
 };
 
 }
@@ -0,0 +1,98 @@
+/**
+ * @file BoundsCheck.h
+ * @author Eliot Fondere
+ * @brief Compile-time policy for out of bounds indices in the containers
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Array::at(), FlashArray::at() and the [] operator of the vectors check their index according to
+ * AEX_BOUNDS_CHECK, which must be defined before including ArduinoExtra:
+ * - AEX_BOUNDS_NONE (default): no check at all, the comparison is removed by the compiler
+ * - AEX_BOUNDS_ASSERT: print the index and the size on Serial, then stop the program
+ * - AEX_BOUNDS_CLAMP: use the last element instead (the container must not be empty)
+ *
+ * Example Usage:
+ * @code
+ * #define AEX_BOUNDS_CHECK AEX_BOUNDS_ASSERT // in test builds only
+ * #include <ArduinoExtra.h>
+ *
+ * aex::Vector<int> values;
+ *
+ * void setup()
+ * {
+ *     Serial.begin(115200);
+ *     values[3] = 1; // prints "aex: index 3 out of bounds (size 0)" and halts
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_BOUNDS_CHECK_H_
+#define _INCLUDE_AEX_BOUNDS_CHECK_H_
+
+#include "utils.h"
+
+#define AEX_BOUNDS_NONE   0 ///< indices are not checked
+#define AEX_BOUNDS_ASSERT 1 ///< out of bounds indices are reported on Serial and halt the program
+#define AEX_BOUNDS_CLAMP  2 ///< out of bounds indices are replaced by the last valid index
+
+#ifndef AEX_BOUNDS_CHECK
+#define AEX_BOUNDS_CHECK AEX_BOUNDS_NONE
+#endif
+
+#if AEX_BOUNDS_CHECK == AEX_BOUNDS_ASSERT
+#include <Arduino.h>
+#endif
+
+namespace aex
+{
+
+namespace priv
+{
+
+#if AEX_BOUNDS_CHECK == AEX_BOUNDS_ASSERT
+/**
+ * @brief Report an out of bounds index on Serial and stop the program
+ *
+ * @param index index that was used
+ * @param size size of the container
+ */
+[[noreturn]] inline void boundsError(size_t index, size_t size)
+{
+    Serial.print(F("aex: index "));
+    Serial.print(static_cast<unsigned long>(index));
+    Serial.print(F(" out of bounds (size "));
+    Serial.print(static_cast<unsigned long>(size));
+    Serial.println(')');
+    Serial.flush();
+
+    noInterrupts();
+
+    while (true)
+    {
+    }
+}
+#endif
+
+/**
+ * @brief Check an index according to AEX_BOUNDS_CHECK
+ *
+ * @param index index used to access a container
+ * @param size size of the container
+ * @return size_t index to use (the same index unless it is clamped)
+ */
+constexpr size_t checkIndex(size_t index, size_t size)
+{
+#if AEX_BOUNDS_CHECK == AEX_BOUNDS_ASSERT
+    return (index < size) ? index : (boundsError(index, size), index);
+#elif AEX_BOUNDS_CHECK == AEX_BOUNDS_CLAMP
+    return (index < size || size == 0) ? index : size - 1;
+#else
+    return (void)size, index;
+#endif
+}
+
+} // namespace priv
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_BOUNDS_CHECK_H_
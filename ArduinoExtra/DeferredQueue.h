@@ -0,0 +1,203 @@
+/**
+ * @file DeferredQueue.h
+ * @author Eliot Fondere
+ * @brief Queue of handlers posted by interrupts and run later in loop()
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * An interrupt only copies a FunctionRef and a small payload into a lock-free RingBuffer, which
+ * takes a few instructions. The handlers then run in loop(), where they can take their time,
+ * use Serial or allocate memory.
+ *
+ * Example Usage:
+ * @code
+ * struct EncoderEvent
+ * {
+ *     uint8_t channel;
+ *     uint16_t ticks;
+ * };
+ *
+ * void onEncoder(const EncoderEvent& event)
+ * {
+ *     Serial.print(event.channel);
+ *     Serial.print(": ");
+ *     Serial.println(event.ticks);
+ * }
+ *
+ * aex::DeferredQueue<EncoderEvent, 32> deferred;
+ *
+ * void encoderISR()
+ * {
+ *     EncoderEvent event = {0, TCNT1};
+ *     deferred.post(onEncoder, event); // returns false if the queue is full
+ * }
+ *
+ * void loop()
+ * {
+ *     deferred.run(1000); // runs the posted handlers for up to about 1 ms
+ *     // ...
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_DEFERRED_QUEUE_H_
+#define _INCLUDE_AEX_DEFERRED_QUEUE_H_
+
+#include "utils.h"
+#include "FunctionRef.h"
+#include "RingBuffer.h"
+
+namespace aex
+{
+
+/**
+ * @brief Lock-free queue of handlers and their payloads, posted by interrupts and run in loop()
+ *
+ * @tparam Payload type of the data passed to the handlers (copied into the queue, keep it small)
+ * @tparam N capacity of the queue (must be a power of two, see RingBuffer)
+ *
+ * Like RingBuffer, there must be a single producer and a single consumer: post() from interrupts
+ * (which do not interrupt each other unless enabled on purpose), run() and clear() from loop(). To
+ * post from loop() as well, disable interrupts around that call.
+ */
+template<typename Payload, size_t N>
+class DeferredQueue
+{
+public:
+    typedef FunctionRef<void(const Payload&)> Handler; ///< type of the handlers
+
+    /**
+     * @brief Add a handler to run later (producer side, safe in an interrupt)
+     *
+     * @param handler function to call (what it refers to must still exist when it runs)
+     * @param payload data passed to the handler (copied)
+     * @return true the handler was added
+     * @return false the queue is full, the handler was dropped (see getDropped())
+     */
+    bool post(Handler handler, const Payload& payload)
+    {
+        Entry entry;
+        entry.handler = handler;
+        entry.payload = payload;
+
+        if (!m_entries.push(entry))
+        {
+            m_dropped = m_dropped + 1;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Run the posted handlers, oldest first (consumer side)
+     *
+     * @param budget time in microseconds after which no other handler is started (0 to run all of
+     * them)
+     * @return size_t number of handlers run
+     *
+     * Only the handlers posted before the call are run, so a handler (or an interrupt) that keeps
+     * posting cannot make this function run forever. The handler running when the budget expires
+     * is not interrupted, the others stay in the queue for the next call.
+     */
+    size_t run(unsigned long budget = 0)
+    {
+        unsigned long start = micros();
+        size_t count = m_entries.getSize();
+        size_t done = 0;
+        Entry entry;
+
+        while (done < count && m_entries.pop(entry))
+        {
+            entry.handler(entry.payload);
+            done++;
+
+            if (budget > 0 && micros() - start >= budget)
+            {
+                break;
+            }
+        }
+
+        return done;
+    }
+
+    /**
+     * @brief Remove all the posted handlers without running them (consumer side)
+     *
+     */
+    void clear()
+    {
+        m_entries.clear();
+    }
+
+    /**
+     * @brief Get the amount of handlers waiting to run
+     *
+     * @return size_t number of handlers (may already be outdated if an interrupt posts)
+     */
+    size_t getSize() const
+    {
+        return m_entries.getSize();
+    }
+
+    /**
+     * @brief Get the capacity of the queue
+     *
+     * @return size_t maximum amount of handlers waiting to run
+     */
+    constexpr size_t getCapacity() const
+    {
+        return N;
+    }
+
+    /**
+     * @brief Check if no handler is waiting to run
+     *
+     * @return true queue is empty
+     * @return false queue is not empty
+     */
+    bool isEmpty() const
+    {
+        return m_entries.isEmpty();
+    }
+
+    /**
+     * @brief Check if the queue is full
+     *
+     * @return true queue is full (post() would fail)
+     * @return false queue is not full
+     */
+    bool isFull() const
+    {
+        return m_entries.isFull();
+    }
+
+    /**
+     * @brief Get the number of handlers dropped because the queue was full
+     *
+     * @return unsigned int number of failed post() calls (wraps around)
+     *
+     * Note: if this is not zero, the queue is too small or run() is not called often enough
+     */
+    unsigned int getDropped() const
+    {
+        return m_dropped;
+    }
+
+private:
+    /**
+     * @brief A posted handler and its payload
+     */
+    struct Entry
+    {
+        Handler handler; ///< function to call
+        Payload payload; ///< data passed to the function
+    };
+
+    RingBuffer<Entry, N> m_entries;        ///< handlers waiting to run
+    volatile unsigned int m_dropped = 0;   ///< failed post() calls (only written by the producer)
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_DEFERRED_QUEUE_H_
@@ -0,0 +1,285 @@
+/**
+ * @file Event.h
+ * @author Eliot Fondere
+ * @brief List of handlers called together when an event happens (signal/slot)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Example Usage:
+ * @code
+ * class Logger
+ * {
+ * public:
+ *     void onDistance(float distance)
+ *     {
+ *         Serial.println(distance);
+ *     }
+ * };
+ *
+ * Logger logger;
+ * aex::Event<float> distanceChanged;
+ *
+ * void setup()
+ * {
+ *     aex::Event<float>::Handle handle = distanceChanged.subscribe(
+ *         aex::Function<void(float)>::bind<Logger, &Logger::onDistance>(logger));
+ *     distanceChanged.subscribe([](float distance) -> void { if (distance < 10.0f) Serial.println("Too close"); });
+ *
+ *     distanceChanged(5.0f); // Calls both handlers
+ *
+ *     distanceChanged.unsubscribe(handle);
+ *     distanceChanged(5.0f); // Only calls the lambda
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_EVENT_H_
+#define _INCLUDE_AEX_EVENT_H_
+
+#include "utils.h"
+#include "Functional.h"
+#include "Vector.h"
+
+namespace aex
+{
+
+/**
+ * @brief Event dispatcher calling every subscribed handler with the same arguments
+ *
+ * @tparam Args Types of the arguments passed to the handlers
+ *
+ * Handlers are stored as Function objects directly in a Vector, so small handlers (functions,
+ * methods, lambdas capturing a few references) never allocate memory, and dispatching calls each
+ * handler in place without copying it.
+ *
+ * Note: handlers can subscribe and unsubscribe (themselves or others) while the event is
+ * dispatched. Handlers subscribed during a dispatch are kept aside and added once it is done, so
+ * they are first called by the next dispatch.
+ */
+template<class... Args>
+class Event
+{
+public:
+	typedef unsigned int Handle; ///< Identifies a subscribed handler (0 is never a valid handle)
+
+	/**
+	 * @brief Add a handler to the event
+	 *
+	 * @param handler Function to call when the event is dispatched
+	 * @return Handle to pass to unsubscribe(), 0 if out of memory (the handler was not added)
+	 */
+	Handle subscribe(Function<void(Args...)> handler)
+	{
+		if (++m_lastHandle == 0)
+		{
+			// skip the invalid handle when wrapping around
+			++m_lastHandle;
+		}
+
+		// the slots must not move while one of their handlers runs, so handlers subscribed during
+		// a dispatch wait in m_pending until it is done
+		Vector<Slot>& slots = m_dispatching ? m_pending : m_slots;
+
+		if (slots.emplaceBack(move(handler), m_lastHandle) == nullptr)
+		{
+			// error: out of memory
+			return 0;
+		}
+
+		return m_lastHandle;
+	}
+
+	/**
+	 * @brief Remove a handler from the event
+	 *
+	 * @param handle Handle returned by subscribe()
+	 * @return true the handler was removed
+	 * @return false there is no handler with this handle
+	 */
+	bool unsubscribe(Handle handle)
+	{
+		if (handle == 0)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < m_slots.getSize(); i++)
+		{
+			if (m_slots[i].handle != handle)
+			{
+				continue;
+			}
+
+			if (m_dispatching)
+			{
+				// removed once the dispatch is done so the loop is not disturbed
+				m_slots[i].handle = 0;
+				m_hasRemovedSlots = true;
+			}
+			else
+			{
+				m_slots.erase(i);
+			}
+
+			return true;
+		}
+
+		for (size_t i = 0; i < m_pending.getSize(); i++)
+		{
+			if (m_pending[i].handle == handle)
+			{
+				// not called yet, safe to remove even during a dispatch
+				m_pending.erase(i);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Call all the handlers in the order in which they were subscribed
+	 *
+	 * @param args Arguments passed to every handler
+	 */
+	void dispatch(Args... args)
+	{
+		bool wasDispatching = m_dispatching;
+		m_dispatching = true;
+
+		for (size_t i = 0; i < m_slots.getSize(); i++)
+		{
+			if (m_slots[i].handle != 0)
+			{
+				m_slots[i].handler(args...);
+			}
+		}
+
+		m_dispatching = wasDispatching;
+
+		if (m_dispatching)
+		{
+			return;
+		}
+
+		if (m_hasRemovedSlots)
+		{
+			// remove the slots unsubscribed during the dispatch in a single pass
+			m_slots.eraseIf([](const Slot& slot) -> bool { return slot.handle == 0; });
+			m_hasRemovedSlots = false;
+		}
+
+		addPendingSlots();
+	}
+
+	/**
+	 * @brief Call all the handlers (same as dispatch())
+	 *
+	 * @param args Arguments passed to every handler
+	 */
+	void operator()(Args... args)
+	{
+		dispatch(args...);
+	}
+
+	/**
+	 * @brief Make sure the event can hold a given amount of handlers without reallocating
+	 *
+	 * @param capacity amount of handlers
+	 */
+	void reserve(size_t capacity)
+	{
+		m_slots.reserve(capacity);
+	}
+
+	/**
+	 * @brief Remove all the handlers
+	 *
+	 */
+	void clear()
+	{
+		if (m_dispatching)
+		{
+			for (size_t i = 0; i < m_slots.getSize(); i++)
+			{
+				m_slots[i].handle = 0;
+			}
+
+			m_hasRemovedSlots = true;
+			m_pending.clear();
+			return;
+		}
+
+		m_slots.clear();
+		m_pending.clear();
+	}
+
+	/**
+	 * @brief Get the amount of subscribed handlers
+	 *
+	 * @return size_t number of handlers
+	 */
+	size_t getSize() const
+	{
+		return m_slots.getSize() + m_pending.getSize();
+	}
+
+	/**
+	 * @brief Check if there is no handler
+	 *
+	 * @return true no handler is subscribed
+	 * @return false at least one handler is subscribed
+	 */
+	bool isEmpty() const
+	{
+		return m_slots.isEmpty() && m_pending.isEmpty();
+	}
+
+private:
+	/**
+	 * @brief A subscribed handler and its handle
+	 */
+	struct Slot
+	{
+		/**
+		 * @brief Create a new slot
+		 *
+		 * @param newHandler Function to call on dispatch (moved into the slot)
+		 * @param newHandle Handle of the handler
+		 */
+		Slot(Function<void(Args...)>&& newHandler, Handle newHandle)
+		: handler(move(newHandler)), handle(newHandle)
+		{
+		}
+
+		Function<void(Args...)> handler; ///< Function called on dispatch
+		Handle                  handle;  ///< Handle of the handler (0 once unsubscribed)
+	};
+
+	/**
+	 * @brief Move the handlers subscribed during a dispatch to the other slots
+	 *
+	 * If out of memory, the remaining handlers stay pending and are added after the next dispatch.
+	 */
+	void addPendingSlots()
+	{
+		size_t added = 0;
+
+		while (added < m_pending.getSize() && m_slots.emplaceBack(move(m_pending[added])) != nullptr)
+		{
+			added++;
+		}
+
+		m_pending.erase(0, added);
+	}
+
+	Vector<Slot> m_slots;                   ///< Subscribed handlers
+	Vector<Slot> m_pending;                 ///< Handlers subscribed during a dispatch (not called yet)
+	Handle       m_lastHandle = 0;          ///< Last handle given by subscribe()
+	bool         m_dispatching = false;     ///< An event is being dispatched
+	bool         m_hasRemovedSlots = false; ///< Some slots were unsubscribed during a dispatch
+};
+
+} // aex
+
+#endif // _INCLUDE_AEX_EVENT_H_
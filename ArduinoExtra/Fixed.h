@@ -0,0 +1,431 @@
+/**
+ * @file Fixed.h
+ * @author Eliot Fondere
+ * @brief Fixed-point numbers for fast math on boards without a floating point unit
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * A fixed-point number is an integer counting fractions of 1 (1/2^FracBits), so adding,
+ * multiplying and comparing them only takes a few integer instructions instead of the hundreds
+ * needed by float on AVR. All the operations saturate: a result too big (or too small) for the
+ * type gives the maximum (or minimum) value instead of wrapping around, which is what a control
+ * loop wants.
+ *
+ * Example Usage:
+ * @code
+ * typedef aex::Q16_16 Gain; // from -32768 to 32767.99998
+ *
+ * const Gain kp = 1.25; // converted at compile time
+ * const Gain ki = 0.05;
+ * Gain integral = 0;
+ *
+ * int16_t pid(int16_t target, int16_t measured)
+ * {
+ *     Gain error = target - measured;
+ *     integral += error * ki;
+ *     return (error * kp + integral).toInt(); // no float operation
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_FIXED_H_
+#define _INCLUDE_AEX_FIXED_H_
+
+#include "utils.h"
+#include <stdint.h>
+
+namespace aex
+{
+
+/**
+ * @brief Signed fixed-point number
+ *
+ * @tparam IntBits number of bits of the integer part, including the sign bit
+ * @tparam FracBits number of bits of the fractional part (resolution of 1/2^FracBits)
+ *
+ * The value is stored in the smallest integer of 8, 16 or 32 bits holding IntBits + FracBits bits
+ * (extra bits extend the integer part). Fixed is trivially copyable, so containers copy and move
+ * it with memcpy.
+ *
+ * Note: conversions from integers and double are implicit so constants and integers can be used
+ * directly in expressions. Conversions from double are meant for constants (computed at compile
+ * time), use fromRaw() or integers in hot paths.
+ */
+template<int IntBits, int FracBits>
+class Fixed
+{
+public:
+    static_assert(IntBits >= 1, "Fixed needs at least the sign bit in its integer part");
+    static_assert(FracBits >= 0, "Fixed cannot have a negative number of fractional bits");
+    static_assert(IntBits + FracBits <= 32, "Fixed is limited to 32 bits");
+
+    /// Integer type storing the value
+    typedef typename conditional<(IntBits + FracBits <= 8), int8_t,
+            typename conditional<(IntBits + FracBits <= 16), int16_t, int32_t>::type>::type raw_t;
+
+    /// Integer type twice as big as raw_t, for the intermediate results of the operations
+    typedef typename conditional<(sizeof(raw_t) == 1), int16_t,
+            typename conditional<(sizeof(raw_t) == 2), int32_t, int64_t>::type>::type wide_t;
+
+    /**
+     * @brief Create an uninitialized number (like int, so arrays of Fixed are trivial)
+     *
+     */
+    Fixed() = default;
+
+    /**
+     * @brief Create a number from an integer
+     *
+     * @param value integer value (saturated to the range of the type)
+     */
+    constexpr Fixed(int value)
+    : m_raw((value > MAX_INT) ? MAX_RAW : (value < MIN_INT) ? MIN_RAW : fromInteger(static_cast<raw_t>(value)))
+    {
+    }
+
+    /**
+     * @brief Create a number from an integer
+     *
+     * @param value integer value (saturated to the range of the type)
+     */
+    constexpr Fixed(long value)
+    : m_raw((value > MAX_INT) ? MAX_RAW : (value < MIN_INT) ? MIN_RAW : fromInteger(static_cast<raw_t>(value)))
+    {
+    }
+
+    /**
+     * @brief Create a number from an unsigned integer
+     *
+     * @param value integer value (saturated to the range of the type)
+     */
+    constexpr Fixed(unsigned int value)
+    : m_raw((value > static_cast<unsigned long>(MAX_INT)) ? MAX_RAW : fromInteger(static_cast<raw_t>(value)))
+    {
+    }
+
+    /**
+     * @brief Create a number from an unsigned integer
+     *
+     * @param value integer value (saturated to the range of the type)
+     */
+    constexpr Fixed(unsigned long value)
+    : m_raw((value > static_cast<unsigned long>(MAX_INT)) ? MAX_RAW : fromInteger(static_cast<raw_t>(value)))
+    {
+    }
+
+    /**
+     * @brief Create a number from a floating point value (meant for constants)
+     *
+     * @param value value rounded to the nearest 1/2^FracBits (saturated to the range of the type)
+     */
+    constexpr Fixed(double value)
+    : m_raw(value * ONE >= MAX_RAW ? MAX_RAW :
+            value * ONE <= MIN_RAW ? MIN_RAW :
+            static_cast<raw_t>(value * ONE + (value >= 0 ? 0.5 : -0.5)))
+    {
+    }
+
+    /**
+     * @brief Convert a number with another format
+     *
+     * @tparam OtherIntBits number of integer bits of the other format (no need to manually type)
+     * @tparam OtherFracBits number of fractional bits of the other format (no need to manually type)
+     * @param other number to convert (truncated to the resolution of this type and saturated)
+     */
+    template<int OtherIntBits, int OtherFracBits>
+    explicit constexpr Fixed(const Fixed<OtherIntBits, OtherFracBits>& other)
+    : m_raw(saturate(OtherFracBits > FracBits
+                     ? static_cast<long long>(other.raw()) >> (OtherFracBits > FracBits ? OtherFracBits - FracBits : 0)
+                     : static_cast<long long>(other.raw()) * (1LL << (FracBits > OtherFracBits ? FracBits - OtherFracBits : 0))))
+    {
+    }
+
+    /**
+     * @brief Create a number from its raw integer representation
+     *
+     * @param raw value multiplied by 2^FracBits
+     * @return Fixed the new number
+     */
+    static constexpr Fixed fromRaw(raw_t raw)
+    {
+        return Fixed(raw, RawTag());
+    }
+
+    /**
+     * @brief Get the biggest number the type can hold
+     *
+     * @return Fixed maximum value
+     */
+    static constexpr Fixed maxValue()
+    {
+        return fromRaw(MAX_RAW);
+    }
+
+    /**
+     * @brief Get the smallest (most negative) number the type can hold
+     *
+     * @return Fixed minimum value
+     */
+    static constexpr Fixed minValue()
+    {
+        return fromRaw(MIN_RAW);
+    }
+
+    /**
+     * @brief Get the raw integer representation
+     *
+     * @return raw_t value multiplied by 2^FracBits
+     */
+    constexpr raw_t raw() const
+    {
+        return m_raw;
+    }
+
+    /**
+     * @brief Convert to an integer, rounding down (towards minus infinity)
+     *
+     * @return long integer part
+     */
+    constexpr long toInt() const
+    {
+        return static_cast<long>(m_raw >> FracBits);
+    }
+
+    /**
+     * @brief Convert to the nearest integer
+     *
+     * @return long rounded value (halves are rounded up)
+     */
+    constexpr long toIntRounded() const
+    {
+        return static_cast<long>((static_cast<wide_t>(m_raw) + HALF) >> FracBits);
+    }
+
+    /**
+     * @brief Convert to a floating point value (slow on boards without a floating point unit)
+     *
+     * @return float value
+     */
+    constexpr float toFloat() const
+    {
+        return m_raw * (1.0f / ONE);
+    }
+
+    /**
+     * @brief Keep the value (for symmetry with the - operator)
+     *
+     * @return Fixed same number
+     */
+    constexpr Fixed operator+() const
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Negate the value
+     *
+     * @return Fixed opposite number (saturated, the opposite of minValue() is maxValue())
+     */
+    constexpr Fixed operator-() const
+    {
+        return fromRaw(saturate(-static_cast<wide_t>(m_raw)));
+    }
+
+    /**
+     * @brief Add two numbers
+     *
+     * @param a first number
+     * @param b second number
+     * @return Fixed saturated sum
+     */
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        return fromRaw(saturate(static_cast<wide_t>(a.m_raw) + b.m_raw));
+    }
+
+    /**
+     * @brief Subtract two numbers
+     *
+     * @param a first number
+     * @param b number subtracted from the first
+     * @return Fixed saturated difference
+     */
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        return fromRaw(saturate(static_cast<wide_t>(a.m_raw) - b.m_raw));
+    }
+
+    /**
+     * @brief Multiply two numbers
+     *
+     * @param a first number
+     * @param b second number
+     * @return Fixed saturated product, rounded to the nearest 1/2^FracBits
+     */
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        return fromRaw(saturate((static_cast<wide_t>(a.m_raw) * b.m_raw + HALF) >> FracBits));
+    }
+
+    /**
+     * @brief Divide two numbers
+     *
+     * @param a dividend
+     * @param b divisor (dividing by zero gives the maximum or minimum value)
+     * @return Fixed saturated quotient, rounded towards zero
+     */
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        return (b.m_raw == 0) ? fromRaw(a.m_raw >= 0 ? MAX_RAW : MIN_RAW)
+                              : fromRaw(saturate((static_cast<wide_t>(a.m_raw) * ONE) / b.m_raw));
+    }
+
+    /**
+     * @brief Add a number to this one
+     *
+     * @param other number to add
+     * @return Fixed& reference to this number
+     */
+    AEX_CONSTEXPR14 Fixed& operator+=(Fixed other)
+    {
+        return (*this = *this + other);
+    }
+
+    /**
+     * @brief Subtract a number from this one
+     *
+     * @param other number to subtract
+     * @return Fixed& reference to this number
+     */
+    AEX_CONSTEXPR14 Fixed& operator-=(Fixed other)
+    {
+        return (*this = *this - other);
+    }
+
+    /**
+     * @brief Multiply this number by another
+     *
+     * @param other number to multiply by
+     * @return Fixed& reference to this number
+     */
+    AEX_CONSTEXPR14 Fixed& operator*=(Fixed other)
+    {
+        return (*this = *this * other);
+    }
+
+    /**
+     * @brief Divide this number by another
+     *
+     * @param other divisor
+     * @return Fixed& reference to this number
+     */
+    AEX_CONSTEXPR14 Fixed& operator/=(Fixed other)
+    {
+        return (*this = *this / other);
+    }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.m_raw == b.m_raw; } ///< compare two numbers
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.m_raw != b.m_raw; } ///< compare two numbers
+    friend constexpr bool operator<(Fixed a, Fixed b)  { return a.m_raw < b.m_raw; }  ///< compare two numbers
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.m_raw <= b.m_raw; } ///< compare two numbers
+    friend constexpr bool operator>(Fixed a, Fixed b)  { return a.m_raw > b.m_raw; }  ///< compare two numbers
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.m_raw >= b.m_raw; } ///< compare two numbers
+
+private:
+    /// raw value of 1
+    static constexpr wide_t ONE = static_cast<wide_t>(1) << FracBits;
+
+    /// raw value of 0.5 (for rounding)
+    static constexpr wide_t HALF = (FracBits > 0) ? (static_cast<wide_t>(1) << (FracBits > 0 ? FracBits - 1 : 0)) : 0;
+
+    /// biggest raw value
+    static constexpr raw_t MAX_RAW = static_cast<raw_t>((static_cast<wide_t>(1) << (8 * sizeof(raw_t) - 1)) - 1);
+
+    /// smallest raw value
+    static constexpr raw_t MIN_RAW = static_cast<raw_t>(-MAX_RAW - 1);
+
+    /// biggest integer that can be represented
+    static constexpr raw_t MAX_INT = static_cast<raw_t>(MAX_RAW >> FracBits);
+
+    /// smallest integer that can be represented
+    static constexpr raw_t MIN_INT = static_cast<raw_t>(MIN_RAW >> FracBits);
+
+    /// unsigned integer type of the same size as raw_t
+    typedef typename conditional<(sizeof(raw_t) == 1), uint8_t,
+            typename conditional<(sizeof(raw_t) == 2), uint16_t, uint32_t>::type>::type uraw_t;
+
+    /**
+     * @brief Tag to select the raw constructor
+     */
+    struct RawTag
+    {
+    };
+
+    /**
+     * @brief Create a number from its raw representation (see fromRaw())
+     *
+     * @param raw raw value
+     */
+    constexpr Fixed(raw_t raw, RawTag)
+    : m_raw(raw)
+    {
+    }
+
+    /**
+     * @brief Convert an integer already limited to [MIN_INT, MAX_INT] without wide arithmetic
+     *
+     * @param value integer to convert
+     * @return raw_t raw value
+     *
+     * The shift is done on the unsigned type so it is defined for negative values (and for -1
+     * when FracBits leaves only the sign bit in the integer part).
+     */
+    static constexpr raw_t fromInteger(raw_t value)
+    {
+        return static_cast<raw_t>(static_cast<uraw_t>(static_cast<uraw_t>(value) << FracBits));
+    }
+
+    /**
+     * @brief Clamp an intermediate result to the range of raw_t
+     *
+     * @tparam W type of the intermediate result (no need to manually type)
+     * @param value intermediate result
+     * @return raw_t saturated raw value
+     */
+    template<typename W>
+    static constexpr raw_t saturate(W value)
+    {
+        return (value > MAX_RAW) ? MAX_RAW : (value < MIN_RAW) ? MIN_RAW : static_cast<raw_t>(value);
+    }
+
+    raw_t m_raw; ///< value multiplied by 2^FracBits
+};
+
+// definitions of the constants (needed when they are bound to a reference)
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::wide_t Fixed<IntBits, FracBits>::ONE;
+
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::wide_t Fixed<IntBits, FracBits>::HALF;
+
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::raw_t Fixed<IntBits, FracBits>::MAX_RAW;
+
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::raw_t Fixed<IntBits, FracBits>::MIN_RAW;
+
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::raw_t Fixed<IntBits, FracBits>::MAX_INT;
+
+template<int IntBits, int FracBits>
+constexpr typename Fixed<IntBits, FracBits>::raw_t Fixed<IntBits, FracBits>::MIN_INT;
+
+typedef Fixed<1, 7>   Q7;     ///< from -1 to 0.992, resolution of 0.0078 (8 bits)
+typedef Fixed<1, 15>  Q15;    ///< from -1 to 0.99997, resolution of 0.00003 (16 bits)
+typedef Fixed<1, 31>  Q31;    ///< from -1 to 0.9999999995 (32 bits)
+typedef Fixed<8, 8>   Q8_8;   ///< from -128 to 127.996, resolution of 0.004 (16 bits)
+typedef Fixed<16, 16> Q16_16; ///< from -32768 to 32767.99998, resolution of 0.000015 (32 bits)
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_FIXED_H_
@@ -0,0 +1,367 @@
+/**
+ * @file FlashArray.h
+ * @author Eliot Fondere
+ * @brief Fixed-Size Array stored in flash memory (PROGMEM) instead of SRAM
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * On AVR boards, constant data is copied to SRAM at startup unless it is declared PROGMEM, in
+ * which case it has to be read with the pgm_read_ functions. FlashArray hides this: it has the same
+ * interface as a read-only Array, but its elements are read from flash. On other boards, constant
+ * data already stays in flash and the elements are read normally.
+ *
+ * Example Usage:
+ * @code
+ * struct Gamma
+ * {
+ *     constexpr uint8_t operator()(size_t index) const
+ *     {
+ *         return (index * index) / 255; // gamma of 2 for LED brightness
+ *     }
+ * };
+ *
+ * const aex::FlashArray<uint8_t, 256> gammaTable PROGMEM = aex::FlashArray<uint8_t, 256>::generate(Gamma());
+ * const aex::FlashArray<int16_t, 4> offsets PROGMEM = {{ -12, 4, 7, -1 }};
+ *
+ * void loop()
+ * {
+ *     analogWrite(LED_BUILTIN, gammaTable[analogRead(A0) / 4]); // no SRAM used by the table
+ *
+ *     for (int16_t offset : offsets)
+ *     {
+ *         Serial.println(offset);
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_FLASH_ARRAY_H_
+#define _INCLUDE_AEX_FLASH_ARRAY_H_
+
+#include "utils.h"
+#include "BoundsCheck.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#endif
+
+namespace aex
+{
+
+namespace priv
+{
+
+/**
+ * @brief Read a value from flash memory, using the fastest pgm_read_ function for its size
+ *
+ * @tparam Size size of the value in bytes
+ */
+template<size_t Size>
+struct FlashReader
+{
+    template<typename T>
+    static T read(const T* address)
+    {
+        T value;
+#if defined(__AVR__)
+        memcpy_P(&value, address, Size);
+#else
+        memcpy(&value, address, Size);
+#endif
+        return value;
+    }
+};
+
+#if defined(__AVR__)
+template<>
+struct FlashReader<1>
+{
+    template<typename T>
+    static T read(const T* address)
+    {
+        uint8_t raw = pgm_read_byte(address);
+        T value;
+        memcpy(&value, &raw, 1);
+        return value;
+    }
+};
+
+template<>
+struct FlashReader<2>
+{
+    template<typename T>
+    static T read(const T* address)
+    {
+        uint16_t raw = pgm_read_word(address);
+        T value;
+        memcpy(&value, &raw, 2);
+        return value;
+    }
+};
+
+template<>
+struct FlashReader<4>
+{
+    template<typename T>
+    static T read(const T* address)
+    {
+        uint32_t raw = pgm_read_dword(address);
+        T value;
+        memcpy(&value, &raw, 4);
+        return value;
+    }
+};
+#endif
+
+/**
+ * @brief Read a value from flash memory
+ *
+ * @tparam T type of the value (no need to manually type)
+ * @param address address of the value in flash
+ * @return T copy of the value
+ */
+template<typename T>
+inline T readFlash(const T* address)
+{
+    return FlashReader<sizeof(T)>::read(address);
+}
+
+/**
+ * @brief Iterator over elements stored in flash (dereferencing returns a copy of the element)
+ *
+ * @tparam T type of the elements
+ */
+template<typename T>
+class FlashIterator
+{
+public:
+    /**
+     * @brief Create an iterator pointing to an element
+     *
+     * @param address address of the element in flash
+     */
+    explicit FlashIterator(const T* address)
+    : m_address(address)
+    {
+    }
+
+    /**
+     * @brief Read the element
+     *
+     * @return T copy of the element
+     */
+    T operator*() const
+    {
+        return readFlash(m_address);
+    }
+
+    /**
+     * @brief Move to the next element
+     *
+     * @return FlashIterator& reference to this iterator
+     */
+    FlashIterator& operator++()
+    {
+        m_address++;
+        return *this;
+    }
+
+    /**
+     * @brief Compare the position of two iterators
+     *
+     * @param other iterator to compare with
+     * @return true the iterators point to the same element
+     * @return false the iterators point to different elements
+     */
+    bool operator==(const FlashIterator& other) const
+    {
+        return (m_address == other.m_address);
+    }
+
+    /**
+     * @brief Compare the position of two iterators
+     *
+     * @param other iterator to compare with
+     * @return true the iterators point to different elements
+     * @return false the iterators point to the same element
+     */
+    bool operator!=(const FlashIterator& other) const
+    {
+        return (m_address != other.m_address);
+    }
+
+private:
+    const T* m_address; ///< address of the element in flash
+};
+
+} // namespace priv
+
+/**
+ * @brief Read-only Array whose elements are read from flash memory
+ *
+ * @tparam T type of data contained in the array (must be trivially copyable)
+ * @tparam S size of the array
+ *
+ * Note: declare the arrays PROGMEM (and const), otherwise they are still copied to SRAM and
+ * reading them gives wrong values on AVR. Elements are returned by value since they cannot be
+ * referenced directly.
+ */
+template<typename T, size_t S>
+class FlashArray
+{
+public:
+    static_assert(is_trivially_copyable<T>::value, "FlashArray elements are copied out of flash byte by byte");
+
+    /**
+     * @brief Get the size of the array
+     *
+     * @return size_t size of the array
+     */
+    constexpr size_t getSize() const
+    {
+        return S;
+    }
+
+    /**
+     * @brief Get the first element of the array
+     *
+     * @return T copy of the first element
+     */
+    T front() const
+    {
+        return priv::readFlash(&m_data[0]);
+    }
+
+    /**
+     * @brief Get the last element of the array
+     *
+     * @return T copy of the last element
+     */
+    T back() const
+    {
+        return priv::readFlash(&m_data[S - 1]);
+    }
+
+    /**
+     * @brief Get the element at a given index in the array
+     *
+     * @param index index or position of the element
+     * @return T copy of the element
+     *
+     * Note: like Array::at(), the index is checked according to AEX_BOUNDS_CHECK (see BoundsCheck.h)
+     */
+    T at(size_t index) const
+    {
+        return priv::readFlash(&m_data[priv::checkIndex(index, S)]);
+    }
+
+    /**
+     * @brief Get the element at a given index in the array
+     *
+     * @param index index or position of the element
+     * @return T copy of the element
+     *
+     * Note: no checks are performed to see if the index is out of bounds
+     */
+    T operator[](size_t index) const
+    {
+        return priv::readFlash(&m_data[index]);
+    }
+
+    /**
+     * @brief Copy a range of elements from flash to SRAM
+     *
+     * @param destination where the elements are copied
+     * @param first index of the first element to copy
+     * @param count number of elements to copy (limited to the end of the array)
+     * @return size_t number of elements copied
+     */
+    size_t copyTo(T* destination, size_t first, size_t count) const
+    {
+        if (first >= S)
+        {
+            return 0;
+        }
+
+        if (count > S - first)
+        {
+            count = S - first;
+        }
+
+#if defined(__AVR__)
+        memcpy_P(destination, &m_data[first], count * sizeof(T));
+#else
+        memcpy(destination, &m_data[first], count * sizeof(T));
+#endif
+        return count;
+    }
+
+    /**
+     * @brief Get the address of the elements in flash
+     *
+     * @return const T* address of the first element (only readable with the pgm_read_ functions on AVR)
+     */
+    constexpr const T* data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     *
+     * @return priv::FlashIterator<T> iterator to the first element
+     */
+    priv::FlashIterator<T> begin() const
+    {
+        return priv::FlashIterator<T>(m_data);
+    }
+
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     *
+     * @return priv::FlashIterator<T> iterator past the last element
+     */
+    priv::FlashIterator<T> end() const
+    {
+        return priv::FlashIterator<T>(m_data + S);
+    }
+
+    /**
+     * @brief Create an array whose elements are computed from their index at compile time
+     *
+     * @tparam Generator type of the generator (no need to manually type)
+     * @param generator constexpr function or functor with a constexpr operator(), called with the
+     * index of every element
+     * @return FlashArray the new array (to be stored in a const PROGMEM variable)
+     *
+     * @see Array::generate()
+     */
+    template<typename Generator>
+    static constexpr FlashArray generate(const Generator& generator)
+    {
+        return generate(generator, make_index_sequence<S>());
+    }
+
+    T m_data[S];  ///< data contained in the array (public so the array can be initialized like a C array)
+
+private:
+    /**
+     * @brief Create an array by calling a generator with every index
+     *
+     * @tparam Generator type of the generator
+     * @tparam I indices of the elements
+     * @param generator function called with every index
+     * @return FlashArray the new array
+     */
+    template<typename Generator, size_t... I>
+    static constexpr FlashArray generate(const Generator& generator, index_sequence<I...>)
+    {
+        return FlashArray{{ static_cast<T>(generator(I))... }};
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_FLASH_ARRAY_H_
@@ -0,0 +1,260 @@
+/**
+ * @file FunctionRef.h
+ * @author Eliot Fondere
+ * @brief Non-owning reference to global functions, static member functions, lambdas and methods
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Unlike Function, a FunctionRef never allocates memory and does not own what it refers to: it is
+ * only an object pointer and a pointer to a small "trampoline" function. It is meant for
+ * callbacks that are called often (interrupts, sensor readings, etc.) where the referenced object
+ * is guaranteed to outlive the FunctionRef.
+ *
+ * Example Usage:
+ * @code
+ * class ExampleClass
+ * {
+ * public:
+ *     void exampleMethod(float value)
+ *     {
+ *         Serial.println(value);
+ *     }
+ * };
+ *
+ * void exampleFunction(float value)
+ * {
+ *     Serial.println(value * 2.0f);
+ * }
+ *
+ * void setup()
+ * {
+ *     ExampleClass exampleObject;
+ *     float offset = 1.0f;
+ *     auto exampleLambda = [&offset](float value) -> void { Serial.println(value + offset); };
+ *
+ *     aex::FunctionRef<void(float)> exampleRef =
+ *         aex::FunctionRef<void(float)>::bind<ExampleClass, &ExampleClass::exampleMethod>(exampleObject);
+ *     exampleRef(3.0f); // Will execute exampleObject.exampleMethod(3.0f)
+ *
+ *     exampleRef = exampleFunction;
+ *     exampleRef(3.0f); // Will execute exampleFunction(3.0f)
+ *
+ *     exampleRef = exampleLambda; // exampleLambda must outlive exampleRef
+ *     exampleRef(3.0f); // Will output "4.00" to the console
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_FUNCTION_REF_H_
+#define _INCLUDE_AEX_FUNCTION_REF_H_
+
+#include "utils.h"
+
+namespace aex
+{
+
+/**
+ * @brief Allow for template specialization of the FunctionRef class
+ *
+ * @see FunctionRef<R(Args...)>
+ */
+template<class... Args> class FunctionRef;
+
+/**
+ * @brief Non-owning, trivially copyable reference to a callable object
+ *
+ * @tparam R Return type of the function
+ * @tparam Args Types of the arguments passed to the function
+ *
+ * @note Write the type like FunctionRef<void(int, float)> and not FunctionRef<void, int, float>.
+ * Temporary capture-less lambdas are accepted since they convert to a function pointer, capturing
+ * lambdas and other functors have to be stored in a variable that outlives the FunctionRef.
+ */
+template<class R, class... Args>
+class FunctionRef<R(Args...)>
+{
+public:
+	/**
+	 * @brief Create a FunctionRef referring to nothing
+	 *
+	 * @note It must be assigned a function before being called. This constructor exists so
+	 * FunctionRefs can be stored in containers of default constructed elements (e.g. RingBuffer).
+	 */
+	FunctionRef()
+	: m_trampoline(nullptr)
+	{
+		m_target.objectPtr = nullptr;
+	}
+
+	/**
+	 * @brief Create a FunctionRef from a simple pointer to a function
+	 *
+	 * @param functionPtr Pointer to the function
+	 *
+	 * @note This constructor is used for global functions, static member functions and
+	 * capture-less lambdas.
+	 */
+	FunctionRef(R(*functionPtr)(Args...))
+	: m_trampoline(&callFunction)
+	{
+		m_target.functionPtr = functionPtr;
+	}
+
+	/**
+	 * @brief Create a FunctionRef referring to a lambda or any other functor
+	 *
+	 * @tparam F Type of the functor (no need to manually type)
+	 * @param functor Reference to the functor (not copied, it must outlive the FunctionRef)
+	 */
+	template<class F, class = typename enable_if<!is_same<typename remove_const<F>::type, FunctionRef>::value>::type>
+	FunctionRef(F& functor)
+	: m_trampoline(&callFunctor<F>)
+	{
+		m_target.objectPtr = const_cast<void*>(static_cast<const void*>(&functor));
+	}
+
+	/**
+	 * @brief Execute the referenced function
+	 *
+	 * @param args Arguments passed to the function
+	 * @return Return value of the function
+	 */
+	R operator()(Args... args) const
+	{
+		return m_trampoline(m_target, forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Create a new FunctionRef for global functions, lambdas and static methods
+	 *
+	 * @param functionPtr Pointer to the function
+	 * @return The new FunctionRef
+	 */
+	static FunctionRef<R(Args...)> bind(R(*functionPtr)(Args...))
+	{
+		return FunctionRef<R(Args...)>(functionPtr);
+	}
+
+	/**
+	 * @brief Create a new FunctionRef for member functions
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the method (i.e. &ClassName::methodName)
+	 * @param objectRef Reference to the object from which the method is called
+	 * @return The new FunctionRef
+	 *
+	 * @note The method is a template parameter so it is called directly (and can be inlined)
+	 * instead of going through a member function pointer.
+	 */
+	template<class C, R(C::*method)(Args...)>
+	static FunctionRef<R(Args...)> bind(C& objectRef)
+	{
+		Target target;
+		target.objectPtr = &objectRef;
+
+		return FunctionRef<R(Args...)>(target, &callMethod<C, method>);
+	}
+
+	/**
+	 * @brief Create a new FunctionRef for const member functions
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the const method (i.e. &ClassName::methodName)
+	 * @param objectRef Const reference to the object from which the method is called
+	 * @return The new FunctionRef
+	 */
+	template<class C, R(C::*method)(Args...) const>
+	static FunctionRef<R(Args...)> bind(const C& objectRef)
+	{
+		Target target;
+		target.objectPtr = const_cast<void*>(static_cast<const void*>(&objectRef));
+
+		return FunctionRef<R(Args...)>(target, &callConstMethod<C, method>);
+	}
+
+private:
+	/**
+	 * @brief What the FunctionRef refers to (only one of the pointers is used at a time)
+	 */
+	union Target
+	{
+		void* objectPtr;              ///< Pointer to the functor or object
+		R(*functionPtr)(Args...);     ///< Pointer to the function
+	};
+
+	using trampoline_t = R(*)(Target, Args...); ///< Type of the function calling the target
+
+	/**
+	 * @brief Create a FunctionRef from a target and the function used to call it
+	 *
+	 * @param target Object or function referred to
+	 * @param trampoline Function calling the target
+	 */
+	FunctionRef(Target target, trampoline_t trampoline)
+	: m_target(target), m_trampoline(trampoline)
+	{
+	}
+
+	/**
+	 * @brief Call a function pointer target
+	 *
+	 * @param target Target containing the function pointer
+	 * @param args Arguments passed to the function
+	 * @return Return value of the function
+	 */
+	static R callFunction(Target target, Args... args)
+	{
+		return target.functionPtr(forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Call a functor target
+	 *
+	 * @tparam F Type of the functor
+	 * @param target Target containing the pointer to the functor
+	 * @param args Arguments passed to the functor
+	 * @return Return value of the functor
+	 */
+	template<class F>
+	static R callFunctor(Target target, Args... args)
+	{
+		return (*static_cast<F*>(target.objectPtr))(forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Call a method target
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the method
+	 * @param target Target containing the pointer to the object
+	 * @param args Arguments passed to the method
+	 * @return Return value of the method
+	 */
+	template<class C, R(C::*method)(Args...)>
+	static R callMethod(Target target, Args... args)
+	{
+		return (static_cast<C*>(target.objectPtr)->*method)(forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Call a const method target
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the const method
+	 * @param target Target containing the pointer to the object
+	 * @param args Arguments passed to the method
+	 * @return Return value of the method
+	 */
+	template<class C, R(C::*method)(Args...) const>
+	static R callConstMethod(Target target, Args... args)
+	{
+		return (static_cast<const C*>(target.objectPtr)->*method)(forward<Args>(args)...);
+	}
+
+	Target       m_target;     ///< Object or function referred to
+	trampoline_t m_trampoline; ///< Function calling the target
+};
+
+} // aex
+
+#endif // _INCLUDE_AEX_FUNCTION_REF_H_
@@ -1,7 +1,7 @@
 /**
  * @file Functional.h
  * @author Eliot Fondere
- * @brief Function wrapper for global functions, static member functions, lambdas and member functions
+ * @brief Function wrapper for global functions, static member functions, lambdas, functors and member functions
  * 
  * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
  *
@@ -35,6 +35,8 @@
  *
  *     aex::Function<void(float)> exampleFunction1 =
  *         aex::Function<void(float)>::bind<ExampleClass>(exampleObject, &ExampleClass::exampleMethod);
+ *     exampleFunction1 =
+ *         aex::Function<void(float)>::bind<ExampleClass, &ExampleClass::exampleMethod>(exampleObject);
  *     exampleFunction1 = aex::Function<void(float)>::bind(ExampleClass::exampleStaticMethod);
  *
  *     exampleFunction1(3.0f); // Will execute ExampleClass::exampleStaticMethod(3.0f)
@@ -43,8 +45,12 @@
  *     	   aex::Function<float(float, float)>::bind(exampleFunction);
  *     Serial.println(exampleFunction2(2.0f, 5.0f)); // Will output "10.00" to the console
  *
- *     aex::Function<void()> exampleFunction2([]() -> void { Serial.println("Lambda Function"); };
- *     exampleFunction2(); // Will write "Lambda Function" to the console
+ *     aex::Function<void()> exampleFunction3([]() -> void { Serial.println("Lambda Function"); });
+ *     exampleFunction3(); // Will write "Lambda Function" to the console
+ *
+ *     int counter = 0;
+ *     aex::Function<void()> exampleFunction4([&counter]() -> void { Serial.println(++counter); });
+ *     exampleFunction4(); // Will write "1" to the console
  * }
  * @endcode
  */
@@ -53,6 +59,20 @@
 #define _INCLUDE_AEX_FUNCTIONAL_H_
 
 #include "utils.h"
+#include "Memory.h"
+#include "Allocator.h"
+#include <new>
+
+/**
+ * @brief Size (in bytes) of the inline buffer used by Function to store its callable object
+ *
+ * Callables that do not fit in this buffer are allocated on the heap instead. By default, the
+ * buffer is big enough for a member function pointer and a reference to an object. Define this
+ * macro before including the library to change it.
+ */
+#ifndef AEX_FUNCTION_BUFFER_SIZE
+#define AEX_FUNCTION_BUFFER_SIZE sizeof(aex::priv::MemberCallable<aex::priv::Placeholder, void()>)
+#endif
 
 namespace aex
 {
@@ -60,21 +80,65 @@ namespace aex
 /**
  * @brief Allow for template specialization of the Function class
  * 
- * @see Function<R(Args...)>
+ * @tparam Signature Signature of the function (i.e. void(int, float))
+ * @tparam Allocator Where callables too large for the inline buffer are allocated (see Allocator.h)
+ * 
+ * @see Function<R(Args...), Allocator>
  */
-template<class... Args> class Function;
+template<class Signature, class Allocator = HeapAllocator> class Function;
 
 namespace priv
 {
 
 /**
  * @brief Allow for template specialization of the Callable classes
- *
- * Todo: Add a callable for const functions?
  */
 template<class...> class Callable;
 template<class...> class FunctionCallable;
 template<class...> class MemberCallable;
+template<class...> class FunctorCallable;
+
+/**
+ * @brief Get the type of a pointer to a method from the class and the signature of the method
+ *
+ * @see BoundMemberCallable
+ */
+template<class C, class Signature> struct MethodPtr;
+
+/**
+ * @brief Template specialization for non-const methods
+ *
+ * @tparam C Type of the class containing the method
+ * @tparam R Return type of the method
+ * @tparam Args Types of arguments passed to the method
+ */
+template<class C, class R, class... Args>
+struct MethodPtr<C, R(Args...)>
+{
+	using type = R(C::*)(Args...); ///< Type of the method pointer
+};
+
+/**
+ * @brief Template specialization for const methods (called on const objects)
+ *
+ * @tparam C Type of the class containing the method
+ * @tparam R Return type of the method
+ * @tparam Args Types of arguments passed to the method
+ */
+template<class C, class R, class... Args>
+struct MethodPtr<const C, R(Args...)>
+{
+	using type = R(C::*)(Args...) const; ///< Type of the method pointer
+};
+
+template<class C, class Signature, typename MethodPtr<C, Signature>::type method> class BoundMemberCallable;
+
+/**
+ * @brief Empty class only used to compute the default size of the Function buffer
+ *
+ * @see AEX_FUNCTION_BUFFER_SIZE
+ */
+class Placeholder {};
 
 /**
  * @brief Callable parent class. Container for a callable object
@@ -86,7 +150,7 @@ template<class R, class... Args>
 class Callable<R(Args...)>
 {
 public:
-	friend class aex::Function<R(Args...)>; // For Callable* copy()
+	template<class, class> friend class aex::Function; // For Callable* copy(), move() and getSize()
 
 	/**
 	 * @brief Execute the callable object
@@ -104,15 +168,34 @@ public:
 
 private:
 	/**
-	 * @brief Copy a Callable object
+	 * @brief Copy a Callable object into a given block of memory
 	 *
+	 * @param destination Memory where the copy is constructed (at least getSize() bytes)
 	 * @return A pointer to the new callable object
 	 *
 	 * @note This function is implemented by the children of this class to allow copying a function
-	 * without losing information on the type of callable. Ownership of the memory is transferred to
-	 * whatever calls this function.
+	 * without losing information on the type of callable. The memory is not allocated by this
+	 * function, whatever calls it is responsible for destroying the copy and freeing the memory.
+	 */
+	virtual Callable* copy(void* destination) const = 0;
+
+	/**
+	 * @brief Move a Callable object into a given block of memory
+	 *
+	 * @param destination Memory where the callable is moved (at least getSize() bytes)
+	 * @return A pointer to the moved callable object
+	 *
+	 * @note Only used for callables stored inside the buffer of a Function, heap-allocated
+	 * callables are moved by transferring the pointer instead.
 	 */
-	virtual Callable* copy() const = 0;
+	virtual Callable* move(void* destination) = 0;
+
+	/**
+	 * @brief Get the size of the callable object
+	 *
+	 * @return Size in bytes of the actual (child) callable type
+	 */
+	virtual size_t getSize() const = 0;
 };
 
 /**
@@ -138,13 +221,35 @@ public:
 	}
 
 	/**
-	 * @brief Copy the FunctionCallable by allocating a new one
+	 * @brief Copy the FunctionCallable into a given block of memory
 	 *
+	 * @param destination Memory where the copy is constructed
 	 * @return Pointer to the new FunctionCallable
 	 */
-	Callable<R(Args...)>* copy() const override
+	Callable<R(Args...)>* copy(void* destination) const override
 	{
-		return new FunctionCallable<R(Args...)>(m_functionPtr);
+		return new(destination) FunctionCallable<R(Args...)>(m_functionPtr);
+	}
+
+	/**
+	 * @brief Move the FunctionCallable into a given block of memory
+	 *
+	 * @param destination Memory where the FunctionCallable is moved
+	 * @return Pointer to the moved FunctionCallable
+	 */
+	Callable<R(Args...)>* move(void* destination) override
+	{
+		return new(destination) FunctionCallable<R(Args...)>(aex::move(*this));
+	}
+
+	/**
+	 * @brief Get the size of the FunctionCallable
+	 *
+	 * @return Size in bytes of the FunctionCallable
+	 */
+	size_t getSize() const override
+	{
+		return sizeof(*this);
 	}
 
 	/**
@@ -191,13 +296,35 @@ public:
 	}
 
 	/**
-	 * @brief Copy the MemberCallable by allocating a new one
+	 * @brief Copy the MemberCallable into a given block of memory
 	 *
+	 * @param destination Memory where the copy is constructed
 	 * @return Pointer to the new MemberCallable
 	 */
-	Callable<R(Args...)>* copy() const override
+	Callable<R(Args...)>* copy(void* destination) const override
 	{
-		return new MemberCallable<C, R(Args...)>(m_objectReference, m_functionPtr);
+		return new(destination) MemberCallable<C, R(Args...)>(m_objectReference, m_functionPtr);
+	}
+
+	/**
+	 * @brief Move the MemberCallable into a given block of memory
+	 *
+	 * @param destination Memory where the MemberCallable is moved
+	 * @return Pointer to the moved MemberCallable
+	 */
+	Callable<R(Args...)>* move(void* destination) override
+	{
+		return new(destination) MemberCallable<C, R(Args...)>(aex::move(*this));
+	}
+
+	/**
+	 * @brief Get the size of the MemberCallable
+	 *
+	 * @return Size in bytes of the MemberCallable
+	 */
+	size_t getSize() const override
+	{
+		return sizeof(*this);
 	}
 
 	/**
@@ -216,6 +343,226 @@ private:
 	functionPtr_t m_functionPtr;     ///< Pointer to the function
 };
 
+/**
+ * @brief Callable type for const member functions / methods called on const objects
+ *
+ * @tparam C Type of the class containing the method
+ * @tparam R Return type of the method
+ * @tparam Args Types of arguments passed to the method
+ */
+template<class C, class R, class... Args>
+class MemberCallable<const C, R(Args...)> : public Callable<R(Args...)>
+{
+public:
+	using functionPtr_t = R(C::*)(Args...) const; ///< Type of the function pointer
+
+	/**
+	 * @brief Create a new MemberCallable from a const reference to an object and a function pointer
+	 *
+	 * @param objectReference Const reference to the object from which the method is called
+	 * @param functionPtr Pointer to the const function
+	 *
+	 * @note Make sure to add the reference symbol before the function pointer (i.e.
+	 * &ClassName::methodName).
+	 */
+	MemberCallable(const C& objectReference, functionPtr_t functionPtr)
+	: m_objectReference(objectReference)
+	{
+		m_functionPtr = functionPtr;
+	}
+
+	/**
+	 * @brief Copy the MemberCallable into a given block of memory
+	 *
+	 * @param destination Memory where the copy is constructed
+	 * @return Pointer to the new MemberCallable
+	 */
+	Callable<R(Args...)>* copy(void* destination) const override
+	{
+		return new(destination) MemberCallable<const C, R(Args...)>(m_objectReference, m_functionPtr);
+	}
+
+	/**
+	 * @brief Move the MemberCallable into a given block of memory
+	 *
+	 * @param destination Memory where the MemberCallable is moved
+	 * @return Pointer to the moved MemberCallable
+	 */
+	Callable<R(Args...)>* move(void* destination) override
+	{
+		return new(destination) MemberCallable<const C, R(Args...)>(aex::move(*this));
+	}
+
+	/**
+	 * @brief Get the size of the MemberCallable
+	 *
+	 * @return Size in bytes of the MemberCallable
+	 */
+	size_t getSize() const override
+	{
+		return sizeof(*this);
+	}
+
+	/**
+	 * @brief Execute the method
+	 *
+	 * @param args Arguments passed to the method
+	 * @return Return value of the method
+	 */
+	R operator()(Args... args) override
+	{
+		return (m_objectReference.*m_functionPtr)(forward<Args>(args)...);
+	}
+
+private:
+	const C&      m_objectReference; ///< Const reference to the object from which the method is called
+	functionPtr_t m_functionPtr;     ///< Pointer to the function
+};
+
+/**
+ * @brief Callable type for member functions / methods known at compile time
+ *
+ * @tparam C Type of the class containing the method (const for const methods)
+ * @tparam R Return type of the method
+ * @tparam Args Types of arguments passed to the method
+ * @tparam method Pointer to the method
+ *
+ * @note Since the method is a template parameter, only the object pointer is stored and the method
+ * is called directly instead of through a member function pointer.
+ */
+template<class C, class R, class... Args, typename MethodPtr<C, R(Args...)>::type method>
+class BoundMemberCallable<C, R(Args...), method> : public Callable<R(Args...)>
+{
+public:
+	/**
+	 * @brief Create a new BoundMemberCallable from a reference to an object
+	 *
+	 * @param objectReference Reference to the object from which the method is called
+	 */
+	explicit BoundMemberCallable(C& objectReference)
+	: m_objectPtr(&objectReference)
+	{
+	}
+
+	/**
+	 * @brief Copy the BoundMemberCallable into a given block of memory
+	 *
+	 * @param destination Memory where the copy is constructed
+	 * @return Pointer to the new BoundMemberCallable
+	 */
+	Callable<R(Args...)>* copy(void* destination) const override
+	{
+		return new(destination) BoundMemberCallable<C, R(Args...), method>(*m_objectPtr);
+	}
+
+	/**
+	 * @brief Move the BoundMemberCallable into a given block of memory
+	 *
+	 * @param destination Memory where the BoundMemberCallable is moved
+	 * @return Pointer to the moved BoundMemberCallable
+	 */
+	Callable<R(Args...)>* move(void* destination) override
+	{
+		return new(destination) BoundMemberCallable<C, R(Args...), method>(*m_objectPtr);
+	}
+
+	/**
+	 * @brief Get the size of the BoundMemberCallable
+	 *
+	 * @return Size in bytes of the BoundMemberCallable
+	 */
+	size_t getSize() const override
+	{
+		return sizeof(*this);
+	}
+
+	/**
+	 * @brief Execute the method
+	 *
+	 * @param args Arguments passed to the method
+	 * @return Return value of the method
+	 */
+	R operator()(Args... args) override
+	{
+		return (m_objectPtr->*method)(forward<Args>(args)...);
+	}
+
+private:
+	C* m_objectPtr; ///< Pointer to the object from which the method is called
+};
+
+/**
+ * @brief Callable type for capturing lambdas and other functors (objects with an operator())
+ *
+ * @tparam F Type of the functor
+ * @tparam R Return type of the functor
+ * @tparam Args Types of arguments passed to the functor
+ *
+ * @note The functor is stored by value, so the state it captures lives as long as the callable.
+ */
+template<class F, class R, class... Args>
+class FunctorCallable<F, R(Args...)> : public Callable<R(Args...)>
+{
+public:
+	/**
+	 * @brief Create a new FunctorCallable by copying or moving a functor
+	 *
+	 * @tparam G Type of the functor passed (no need to manually type)
+	 * @param functor Functor to store
+	 */
+	template<class G>
+	explicit FunctorCallable(G&& functor)
+	: m_functor(forward<G>(functor))
+	{
+	}
+
+	/**
+	 * @brief Copy the FunctorCallable into a given block of memory
+	 *
+	 * @param destination Memory where the copy is constructed
+	 * @return Pointer to the new FunctorCallable
+	 */
+	Callable<R(Args...)>* copy(void* destination) const override
+	{
+		return new(destination) FunctorCallable<F, R(Args...)>(m_functor);
+	}
+
+	/**
+	 * @brief Move the FunctorCallable into a given block of memory
+	 *
+	 * @param destination Memory where the FunctorCallable is moved
+	 * @return Pointer to the moved FunctorCallable
+	 */
+	Callable<R(Args...)>* move(void* destination) override
+	{
+		return new(destination) FunctorCallable<F, R(Args...)>(aex::move(m_functor));
+	}
+
+	/**
+	 * @brief Get the size of the FunctorCallable
+	 *
+	 * @return Size in bytes of the FunctorCallable
+	 */
+	size_t getSize() const override
+	{
+		return sizeof(*this);
+	}
+
+	/**
+	 * @brief Execute the functor
+	 *
+	 * @param args Arguments passed to the functor
+	 * @return Return value of the functor
+	 */
+	R operator()(Args... args) override
+	{
+		return m_functor(forward<Args>(args)...);
+	}
+
+private:
+	F m_functor; ///< Stored functor
+};
+
 } // priv
 
 /**
@@ -223,11 +570,15 @@ private:
  *
  * @tparam R Return type of the function
  * @tparam Args Types of the arguments passed to the function
+ * @tparam Allocator Where callables too large for the inline buffer are allocated
  *
  * @note Write the type like Function<void(int, float)> and not Function<void, int, float>.
+ *
+ * Small callable objects (see AEX_FUNCTION_BUFFER_SIZE) are constructed in place inside the
+ * Function object, so creating, copying and destroying them does not use the heap.
  */
-template<class R, class... Args>
-class Function<R(Args...)>
+template<class R, class... Args, class Allocator>
+class Function<R(Args...), Allocator>
 {
 public:
 	/**
@@ -236,11 +587,26 @@ public:
 	 * @param functionPtr Pointer to the function
 	 *
 	 * @note This constructor is used to make it easier to create Function objects from global
-	 * functions, static member functions and lambdas.
+	 * functions and static member functions.
 	 */
 	Function(R(*functionPtr)(Args...))
 	{
-		m_callable = new priv::FunctionCallable<R(Args...)>(functionPtr);
+		create<priv::FunctionCallable<R(Args...)>>(functionPtr);
+	}
+
+	/**
+	 * @brief Create a Function object from a lambda (capturing or not) or any other functor
+	 *
+	 * @tparam F Type of the functor (no need to manually type)
+	 * @param functor Functor to copy or move into the Function object
+	 *
+	 * @note The functor is stored in the inline buffer if it fits (a lambda capturing a couple of
+	 * references or pointers usually does), or on the heap otherwise.
+	 */
+	template<class F, class = typename enable_if<!is_same<typename remove_const<typename remove_reference<F>::type>::type, Function>::value>::type>
+	Function(F&& functor)
+	{
+		create<priv::FunctorCallable<typename remove_const<typename remove_reference<F>::type>::type, R(Args...)>>(forward<F>(functor));
 	}
 
 	/**
@@ -250,7 +616,7 @@ public:
 	 */
 	Function(Function& other)
 	{
-		m_callable = other.m_callable->copy();
+		copyFrom(other);
 	}
 
 	/**
@@ -260,7 +626,19 @@ public:
 	 */
 	Function(const Function& other)
 	{
-		m_callable = other.m_callable->copy();
+		copyFrom(other);
+	}
+
+	/**
+	 * @brief Create a Function object by moving another
+	 *
+	 * @param other Function object to move (left empty)
+	 *
+	 * @note No memory is allocated, heap-allocated callables are transferred as is
+	 */
+	Function(Function&& other)
+	{
+		moveFrom(other);
 	}
 
 	/**
@@ -269,17 +647,16 @@ public:
 	 * @param other Function object to copy
 	 * @return Reference to this object
 	 *
-	 * @note Safely deletes the previous callable object if necessary
+	 * @note Safely destroys the previous callable object if necessary
 	 */
 	Function& operator=(Function& other)
 	{
-		if (m_callable)
+		if (this != &other)
 		{
-			delete m_callable;
+			reset();
+			copyFrom(other);
 		}
 
-		m_callable = other.m_callable->copy();
-
 		return *this;
 	}
 
@@ -289,27 +666,44 @@ public:
 	 * @param other Function object to copy
 	 * @return Reference to this object
 	 *
-	 * @note Safely deletes the previous callable object if necessary
+	 * @note Safely destroys the previous callable object if necessary
 	 */
 	Function& operator=(const Function& other)
 	{
-		if (m_callable)
+		if (this != &other)
 		{
-			delete m_callable;
+			reset();
+			copyFrom(other);
 		}
 
-		m_callable = other.m_callable->copy();
+		return *this;
+	}
+
+	/**
+	 * @brief Move a Function object
+	 *
+	 * @param other Function object to move (left empty)
+	 * @return Reference to this object
+	 *
+	 * @note Safely destroys the previous callable object if necessary
+	 */
+	Function& operator=(Function&& other)
+	{
+		if (this != &other)
+		{
+			reset();
+			moveFrom(other);
+		}
 
 		return *this;
 	}
 
 	/**
-	 * @brief Destroy the Function object and delete the callable object
+	 * @brief Destroy the Function object and its callable object
 	 */
 	~Function()
 	{
-		if (m_callable)
-			delete m_callable;
+		reset();
 	}
 
 	/**
@@ -329,9 +723,9 @@ public:
 	 * @param functionPtr Pointer to the function
 	 * @return The new function object
 	 */
-	static Function<R(Args...)> bind(R(*functionPtr)(Args...))
+	static Function bind(R(*functionPtr)(Args...))
 	{
-		return {new priv::FunctionCallable<R(Args...)>(functionPtr)};
+		return Function(functionPtr);
 	}
 
 	/**
@@ -343,26 +737,198 @@ public:
 	 * @return The new function object
 	 */
 	template<class C>
-	static Function<R(Args...)> bind(C& objectRef, R(C::*functionPtr)(Args...))
+	static Function bind(C& objectRef, R(C::*functionPtr)(Args...))
 	{
-		return {new priv::MemberCallable<C, R(Args...)>(objectRef, functionPtr)};
+		Function function;
+		function.template create<priv::MemberCallable<C, R(Args...)>>(objectRef, functionPtr);
+		return function;
+	}
+
+	/**
+	 * @brief Create a new function object for member functions known at compile time
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the method (i.e. &ClassName::methodName)
+	 * @param objectRef Reference to the object from which the method is called
+	 * @return The new function object
+	 *
+	 * @note Prefer this overload when the method is known at compile time: only the object
+	 * pointer is stored and the method is called directly (and can be inlined).
+	 */
+	template<class C, R(C::*method)(Args...)>
+	static Function bind(C& objectRef)
+	{
+		Function function;
+		function.template create<priv::BoundMemberCallable<C, R(Args...), method>>(objectRef);
+		return function;
 	}
 
-private:
 	/**
-	 * @brief Create a Function using a pointer to a callable
+	 * @brief Create a new function object for const member functions
 	 *
-	 * @param callable Pointer to the heap-allocated callable object
+	 * @tparam C Type of the class containing the method
+	 * @param objectRef Const reference to the object from which the method is called
+	 * @param functionPtr Pointer to the const function
+	 * @return The new function object
+	 */
+	template<class C>
+	static Function bind(const C& objectRef, R(C::*functionPtr)(Args...) const)
+	{
+		Function function;
+		function.template create<priv::MemberCallable<const C, R(Args...)>>(objectRef, functionPtr);
+		return function;
+	}
+
+	/**
+	 * @brief Create a new function object for const member functions known at compile time
+	 *
+	 * @tparam C Type of the class containing the method
+	 * @tparam method Pointer to the const method (i.e. &ClassName::methodName)
+	 * @param objectRef Const reference to the object from which the method is called
+	 * @return The new function object
+	 */
+	template<class C, R(C::*method)(Args...) const>
+	static Function bind(const C& objectRef)
+	{
+		Function function;
+		function.template create<priv::BoundMemberCallable<const C, R(Args...), method>>(objectRef);
+		return function;
+	}
+
+private:
+	/**
+	 * @brief Create an empty Function
 	 *
 	 * @see Function::bind()
-	 * @note The ownership of the pointer is assumed to be transferred to the new Function object
+	 * @note The callable object is expected to be created right after with create()
+	 */
+	Function()
+	{
+	}
+
+	/**
+	 * @brief Construct the callable object, in the inline buffer if it fits, or on the heap
+	 *
+	 * @tparam T Type of the callable object
+	 * @tparam CArgs Types of the arguments passed to the constructor of the callable object
+	 * @param args Arguments passed to the constructor of the callable object
 	 */
-	Function(priv::Callable<R(Args...)>* callable)
-	: m_callable(callable)
+	template<class T, class... CArgs>
+	void create(CArgs&&... args)
 	{
+		void* destination = m_buffer;
+
+		if (sizeof(T) > sizeof(m_buffer) || alignof(T) > alignof(priv::MaxAlign))
+		{
+			destination = Allocator::allocate(sizeof(T));
+
+			if (destination == nullptr)
+			{
+				// error: out of memory, the Function stays empty
+				return;
+			}
+		}
+
+		m_callable = new(destination) T(forward<CArgs>(args)...);
+	}
+
+	/**
+	 * @brief Copy the callable object of another Function into this one
+	 *
+	 * @param other Function object to copy
+	 *
+	 * @note The copy is stored in the inline buffer if the original is, so it never allocates
+	 * memory for small callables.
+	 */
+	void copyFrom(const Function& other)
+	{
+		if (other.m_callable == nullptr)
+		{
+			m_callable = nullptr;
+			return;
+		}
+
+		void* destination = m_buffer;
+
+		if (!other.isInline())
+		{
+			destination = Allocator::allocate(other.m_callable->getSize());
+
+			if (destination == nullptr)
+			{
+				// error: out of memory, the Function stays empty
+				m_callable = nullptr;
+				return;
+			}
+		}
+
+		m_callable = other.m_callable->copy(destination);
+	}
+
+	/**
+	 * @brief Move the callable object of another Function into this one
+	 *
+	 * @param other Function object to move (left empty)
+	 *
+	 * @note Heap-allocated callables are transferred by stealing the pointer, so no memory is
+	 * allocated or freed. Inline callables are moved from one buffer to the other.
+	 */
+	void moveFrom(Function& other)
+	{
+		if (other.m_callable == nullptr)
+		{
+			m_callable = nullptr;
+			return;
+		}
+
+		if (other.isInline())
+		{
+			m_callable = other.m_callable->move(m_buffer);
+			other.reset();
+		}
+		else
+		{
+			m_callable = other.m_callable;
+			other.m_callable = nullptr;
+		}
+	}
+
+	/**
+	 * @brief Destroy the callable object and free its memory if it was on the heap
+	 */
+	void reset()
+	{
+		if (m_callable == nullptr)
+		{
+			return;
+		}
+
+		bool wasInline = isInline();
+		size_t size = m_callable->getSize();
+		m_callable->~Callable();
+
+		if (!wasInline)
+		{
+			Allocator::deallocate(static_cast<void*>(m_callable), size);
+		}
+
+		m_callable = nullptr;
+	}
+
+	/**
+	 * @brief Check if the callable object is stored in the inline buffer
+	 *
+	 * @return true the callable object is in the inline buffer
+	 * @return false the callable object is on the heap (or there is none)
+	 */
+	bool isInline() const
+	{
+		return static_cast<const void*>(m_callable) == static_cast<const void*>(m_buffer);
 	}
 
 	priv::Callable<R(Args...)>* m_callable = nullptr; ///< Internal callable object
+
+	alignas(priv::MaxAlign) unsigned char m_buffer[AEX_FUNCTION_BUFFER_SIZE]; ///< Inline storage for small callables
 };
 
 } // aex
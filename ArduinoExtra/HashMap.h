@@ -0,0 +1,261 @@
+/**
+ * @file HashMap.h
+ * @author Eliot Fondere
+ * @brief Hash Map Container growing on the heap
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Example Usage:
+ * @code
+ * aex::HashMap<uint16_t, int> counts;
+ *
+ * void onValue(uint16_t value)
+ * {
+ *     if (int* count = counts.find(value))
+ *     {
+ *         (*count)++;
+ *     }
+ *     else
+ *     {
+ *         counts.insert(value, 1);
+ *     }
+ * }
+ *
+ * counts.forEach([](const uint16_t& value, int& count) -> void
+ * {
+ *     Serial.print(value);
+ *     Serial.print(": ");
+ *     Serial.println(count);
+ * });
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_HASH_MAP_H_
+#define _INCLUDE_AEX_HASH_MAP_H_
+
+#include "utils.h"
+#include "HashMapBase.h"
+#include "Allocator.h"
+
+namespace aex
+{
+
+/**
+ * @brief Hash map allocating its entries with an allocator (open addressing)
+ *
+ * @tparam K type of the keys
+ * @tparam V type of the values
+ * @tparam Allocator where the entries are allocated (see Allocator.h)
+ * @tparam H how keys are hashed and compared (see Hash)
+ *
+ * The capacity doubles (starting at 8) when the map would be more than three quarters full. The
+ * entries and their used flags share a single allocation. If the allocator runs out of memory,
+ * the map keeps filling its current slots and inserting fails once they are all used.
+ */
+template<typename K, typename V, typename Allocator = HeapAllocator, typename H = Hash<K>>
+class HashMap : public priv::HashMapBase<K, V, H, HashMap<K, V, Allocator, H>>
+{
+    typedef priv::HashMapBase<K, V, H, HashMap> Base;
+
+public:
+    /**
+     * @brief Initialize an empty map (does not allocate)
+     *
+     */
+    HashMap()
+    : Base(nullptr, nullptr, 0)
+    {
+    }
+
+    /**
+     * @brief Initialize an empty map able to hold a given amount of entries without growing
+     *
+     * @param initialSize amount of entries to reserve memory for
+     */
+    HashMap(size_t initialSize)
+    : Base(nullptr, nullptr, 0)
+    {
+        reserve(initialSize);
+    }
+
+    /**
+     * @brief Initialize a map by copying another
+     *
+     * @param other map to copy
+     */
+    HashMap(const HashMap& other)
+    : Base(nullptr, nullptr, 0)
+    {
+        reserve(other.getSize());
+        this->copyFrom(other);
+    }
+
+    /**
+     * @brief Initialize a map by taking the memory of another
+     *
+     * @param other map to move (left empty)
+     */
+    HashMap(HashMap&& other)
+    : Base(nullptr, nullptr, 0)
+    {
+        this->takeFrom(other);
+    }
+
+    /**
+     * @brief Copy the entries of another map
+     *
+     * @param other map to copy
+     * @return HashMap& reference to this map
+     */
+    HashMap& operator=(const HashMap& other)
+    {
+        if (this != &other)
+        {
+            this->clear();
+            reserve(other.getSize());
+            this->copyFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Take the memory of another map
+     *
+     * @param other map to move (left empty)
+     * @return HashMap& reference to this map
+     */
+    HashMap& operator=(HashMap&& other)
+    {
+        if (this != &other)
+        {
+            this->takeFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Empty the map and free memory
+     *
+     */
+    ~HashMap()
+    {
+        this->release();
+    }
+
+    /**
+     * @brief Grow the map so it can hold a given amount of entries without growing again
+     *
+     * @param size amount of entries
+     * @return true the map can hold this amount of entries
+     * @return false out of memory (the capacity did not change)
+     */
+    bool reserve(size_t size)
+    {
+        size_t capacity = getGrowth(size);
+
+        while (capacity != this->m_capacity && !fitsUnderLoad(size, capacity))
+        {
+            capacity *= 2;
+        }
+
+        return (capacity == this->m_capacity || this->rehash(capacity));
+    }
+
+private:
+    friend Base; // for the memory management functions
+
+    typedef typename Base::Entry Entry;
+
+    /**
+     * @brief Allocate the entries and their used flags in a single block
+     *
+     * @param capacity amount of entries the block must hold
+     * @param entries set to the address of the entries
+     * @param used set to the address of the used flags (all false)
+     * @return true the block was allocated
+     * @return false out of memory
+     */
+    bool allocate(size_t capacity, Entry*& entries, bool*& used)
+    {
+        unsigned char* block = static_cast<unsigned char*>(Allocator::allocate(getBlockSize(capacity)));
+
+        if (block == nullptr)
+        {
+            return false;
+        }
+
+        entries = reinterpret_cast<Entry*>(block);
+        used = reinterpret_cast<bool*>(block + capacity * sizeof(Entry));
+
+        for (size_t i = 0; i < capacity; i++)
+        {
+            used[i] = false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Free a block allocated by allocate()
+     *
+     * @param entries address of the entries (nothing is done for nullptr)
+     * @param capacity amount of entries the block can hold
+     */
+    void deallocate(Entry* entries, bool*, size_t capacity)
+    {
+        // prevent deletion of an empty/uninitialized map
+        if (entries == nullptr)
+        {
+            return;
+        }
+
+        Allocator::deallocate(entries, getBlockSize(capacity));
+    }
+
+    /**
+     * @brief Get the capacity needed to hold an amount of entries under the maximum load
+     *
+     * @param required amount of entries
+     * @return size_t double the current capacity (at least 8) if they do not fit, the current
+     * capacity otherwise
+     */
+    size_t getGrowth(size_t required) const
+    {
+        if (fitsUnderLoad(required, this->m_capacity))
+        {
+            return this->m_capacity;
+        }
+
+        return (this->m_capacity > 0) ? this->m_capacity * 2 : 8;
+    }
+
+    /**
+     * @brief Check if an amount of entries keeps a capacity at most three quarters full
+     *
+     * @param size amount of entries
+     * @param capacity amount of slots
+     * @return true the load is acceptable
+     * @return false lookups would be too slow
+     */
+    static bool fitsUnderLoad(size_t size, size_t capacity)
+    {
+        return (size * 4 <= capacity * 3);
+    }
+
+    /**
+     * @brief Get the size of the block holding a given amount of entries and their flags
+     *
+     * @param capacity amount of entries
+     * @return size_t size of the block in bytes
+     */
+    static size_t getBlockSize(size_t capacity)
+    {
+        return capacity * (sizeof(Entry) + sizeof(bool));
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_HASH_MAP_H_
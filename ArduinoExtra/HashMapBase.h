@@ -0,0 +1,576 @@
+/**
+ * @file HashMapBase.h
+ * @author Eliot Fondere
+ * @brief Hash functions and open-addressing table shared by the hash map containers
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ */
+
+#ifndef _INCLUDE_AEX_HASH_MAP_BASE_H_
+#define _INCLUDE_AEX_HASH_MAP_BASE_H_
+
+#include "utils.h"
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+namespace aex
+{
+
+/**
+ * @brief How keys are hashed and compared by the hash maps
+ *
+ * @tparam K type of the keys
+ *
+ * The default works for integers, enums and pointers. Specialize it for other key types with:
+ * - static size_t hash(const K& key): spread the keys over all the bits
+ * - static bool equal(const K& a, const K& b): check if two keys are the same
+ */
+template<typename K>
+struct Hash
+{
+    /**
+     * @brief Hash an integer key (mixes the bits so consecutive keys do not collide)
+     *
+     * @param key key to hash
+     * @return size_t hash of the key
+     */
+    static size_t hash(const K& key)
+    {
+        uint32_t value = static_cast<uint32_t>(key);
+        value ^= value >> 16;
+        value *= 0x45D9F3BUL;
+        value ^= value >> 16;
+        return static_cast<size_t>(value);
+    }
+
+    /**
+     * @brief Compare two keys
+     *
+     * @param a first key
+     * @param b second key
+     * @return true the keys are equal
+     * @return false the keys are different
+     */
+    static bool equal(const K& a, const K& b)
+    {
+        return (a == b);
+    }
+};
+
+/**
+ * @brief Template specialization for pointer keys (hashes the address)
+ *
+ * @tparam T type pointed to
+ *
+ * @see Hash
+ */
+template<typename T>
+struct Hash<T*>
+{
+    static size_t hash(T* key)
+    {
+        return Hash<uintptr_t>::hash(reinterpret_cast<uintptr_t>(key));
+    }
+
+    static bool equal(T* a, T* b)
+    {
+        return (a == b);
+    }
+};
+
+/**
+ * @brief Template specialization for C string keys (hashes and compares the characters)
+ *
+ * Uses the FNV-1a hash. The strings are not copied, they must outlive the map (string literals
+ * for example).
+ *
+ * @see Hash
+ */
+template<>
+struct Hash<const char*>
+{
+    static size_t hash(const char* key)
+    {
+        uint32_t value = 2166136261UL;
+
+        for (; *key != '\0'; key++)
+        {
+            value ^= static_cast<uint8_t>(*key);
+            value *= 16777619UL;
+        }
+
+        return static_cast<size_t>(value);
+    }
+
+    static bool equal(const char* a, const char* b)
+    {
+        return (a == b || strcmp(a, b) == 0);
+    }
+};
+
+namespace priv
+{
+
+/**
+ * @brief A key and its value stored in a hash map
+ *
+ * @tparam K type of the key
+ * @tparam V type of the value
+ */
+template<typename K, typename V>
+struct HashMapEntry
+{
+    /**
+     * @brief Create an entry
+     *
+     * @tparam Arg type of the value argument (no need to manually type)
+     * @param newKey key of the entry
+     * @param newValue value of the entry (copied or moved)
+     */
+    template<typename Arg>
+    HashMapEntry(const K& newKey, Arg&& newValue)
+    : key(newKey), value(forward<Arg>(newValue))
+    {
+    }
+
+    K key;   ///< key of the entry
+    V value; ///< value associated with the key
+};
+
+/**
+ * @brief Common implementation of StaticHashMap and HashMap (open addressing with linear probing)
+ *
+ * @tparam K type of the keys
+ * @tparam V type of the values
+ * @tparam H how keys are hashed and compared (see Hash)
+ * @tparam Derived hash map class inheriting from this one
+ *
+ * The capacity is always a power of two so the hash is reduced with a mask. Removed entries are
+ * filled by shifting the following entries back, so there are no tombstones slowing down lookups.
+ *
+ * The derived class only decides where the memory comes from by implementing:
+ * - bool allocate(size_t capacity, Entry*& entries, bool*& used): get blocks for capacity entries
+ *   and their used flags (false if the map cannot use this capacity)
+ * - void deallocate(Entry* entries, bool* used, size_t capacity): free blocks from allocate()
+ * - size_t getGrowth(size_t required) const: capacity to grow to when required entries do not
+ *   fit under the maximum load, or the current capacity if the map cannot grow
+ */
+template<typename K, typename V, typename H, typename Derived>
+class HashMapBase
+{
+public:
+    typedef HashMapEntry<K, V> Entry; ///< type of the entries
+
+    /**
+     * @brief Add an entry, or replace the value if the key is already in the map
+     *
+     * @param key key of the entry
+     * @param value value associated with the key (to be copied)
+     * @return V* pointer to the value in the map, nullptr if the map is full (nothing was added)
+     */
+    V* insert(const K& key, const V& value)
+    {
+        return emplace(key, value);
+    }
+
+    /**
+     * @brief Add an entry, or replace the value if the key is already in the map
+     *
+     * @param key key of the entry
+     * @param value rvalue reference to the value associated with the key
+     * @return V* pointer to the value in the map, nullptr if the map is full (nothing was added)
+     */
+    V* insert(const K& key, V&& value)
+    {
+        return emplace(key, move(value));
+    }
+
+    /**
+     * @brief Find the value associated with a key
+     *
+     * @param key key to look for
+     * @return V* pointer to the value, nullptr if the key is not in the map
+     */
+    V* find(const K& key)
+    {
+        size_t index = findIndex(key);
+        return (index < m_capacity) ? &m_entries[index].value : nullptr;
+    }
+
+    /**
+     * @brief Find the value associated with a key
+     *
+     * @param key key to look for
+     * @return const V* pointer to the value (read only), nullptr if the key is not in the map
+     */
+    const V* find(const K& key) const
+    {
+        size_t index = findIndex(key);
+        return (index < m_capacity) ? &m_entries[index].value : nullptr;
+    }
+
+    /**
+     * @brief Check if a key is in the map
+     *
+     * @param key key to look for
+     * @return true there is an entry with this key
+     * @return false there is no entry with this key
+     */
+    bool contains(const K& key) const
+    {
+        return (findIndex(key) < m_capacity);
+    }
+
+    /**
+     * @brief Remove an entry
+     *
+     * @param key key of the entry
+     * @return true the entry was removed
+     * @return false there is no entry with this key
+     */
+    bool remove(const K& key)
+    {
+        size_t hole = findIndex(key);
+
+        if (hole >= m_capacity)
+        {
+            return false;
+        }
+
+        m_entries[hole].~Entry();
+        m_used[hole] = false;
+        m_size--;
+
+        // shift back the following entries that are allowed to be in the hole (between their
+        // ideal slot and where they are), so every entry stays reachable from its ideal slot
+        size_t mask = m_capacity - 1;
+
+        for (size_t index = (hole + 1) & mask; m_used[index]; index = (index + 1) & mask)
+        {
+            size_t ideal = H::hash(m_entries[index].key) & mask;
+
+            if (((index - ideal) & mask) < ((index - hole) & mask))
+            {
+                continue;
+            }
+
+            new(&m_entries[hole]) Entry(move(m_entries[index]));
+            m_entries[index].~Entry();
+            m_used[hole] = true;
+            m_used[index] = false;
+            hole = index;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Call a function with every entry of the map (in no particular order)
+     *
+     * @tparam F type of the function (no need to manually type)
+     * @param function called with the key (const K&) and the value (V&) of every entry
+     *
+     * Note: entries must not be added or removed by the function
+     */
+    template<typename F>
+    void forEach(F function)
+    {
+        for (size_t i = 0; i < m_capacity; i++)
+        {
+            if (m_used[i])
+            {
+                function(static_cast<const K&>(m_entries[i].key), m_entries[i].value);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove all the entries
+     *
+     */
+    void clear()
+    {
+        for (size_t i = 0; i < m_capacity; i++)
+        {
+            if (m_used[i])
+            {
+                m_entries[i].~Entry();
+                m_used[i] = false;
+            }
+        }
+
+        m_size = 0;
+    }
+
+    /**
+     * @brief Get the amount of entries in the map
+     *
+     * @return size_t number of entries
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Get the current capacity of the map
+     *
+     * @return size_t amount of slots (entries that can be stored without growing)
+     */
+    size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Check if the map is empty
+     *
+     * @return true map is empty
+     * @return false map is not empty
+     */
+    bool isEmpty() const
+    {
+        return (m_size == 0);
+    }
+
+protected:
+    /**
+     * @brief Initialize the map with blocks of memory given by the derived class
+     *
+     * @param entries block of memory for the entries (can be nullptr if capacity is zero)
+     * @param used used flags of the entries, all false (can be nullptr if capacity is zero)
+     * @param capacity amount of entries the blocks can hold (zero or a power of two)
+     */
+    HashMapBase(Entry* entries, bool* used, size_t capacity)
+    : m_entries(entries), m_used(used), m_capacity(capacity)
+    {
+    }
+
+    HashMapBase(const HashMapBase&) = delete;            ///< copying is implemented by the derived class
+    HashMapBase& operator=(const HashMapBase&) = delete; ///< copying is implemented by the derived class
+
+    /**
+     * @brief Replace the content of the map with a copy of another (used by the derived class)
+     *
+     * @param other map to copy
+     */
+    void copyFrom(const HashMapBase& other)
+    {
+        clear();
+
+        for (size_t i = 0; i < other.m_capacity; i++)
+        {
+            if (other.m_used[i])
+            {
+                emplace(other.m_entries[i].key, other.m_entries[i].value);
+            }
+        }
+    }
+
+    /**
+     * @brief Replace the content of the map by moving the entries of another one by one (used by
+     * the derived class when its memory cannot be transferred)
+     *
+     * @param other map to move (left empty)
+     */
+    void moveEntriesFrom(HashMapBase& other)
+    {
+        clear();
+
+        for (size_t i = 0; i < other.m_capacity; i++)
+        {
+            if (other.m_used[i])
+            {
+                emplace(other.m_entries[i].key, move(other.m_entries[i].value));
+            }
+        }
+
+        other.clear();
+    }
+
+    /**
+     * @brief Replace the content of the map by taking the memory of another (used by the derived
+     * class when its memory can be transferred)
+     *
+     * @param other map to move (left empty, without memory)
+     */
+    void takeFrom(HashMapBase& other)
+    {
+        release();
+
+        m_entries  = other.m_entries;
+        m_used     = other.m_used;
+        m_capacity = other.m_capacity;
+        m_size     = other.m_size;
+
+        other.m_entries  = nullptr;
+        other.m_used     = nullptr;
+        other.m_capacity = 0;
+        other.m_size     = 0;
+    }
+
+    /**
+     * @brief Destroy all entries and free the memory (used by the destructor of the derived class)
+     *
+     */
+    void release()
+    {
+        clear();
+        derived().deallocate(m_entries, m_used, m_capacity);
+        m_entries  = nullptr;
+        m_used     = nullptr;
+        m_capacity = 0;
+    }
+
+    /**
+     * @brief Move the entries to blocks of memory of another capacity
+     *
+     * @param newCapacity new capacity (a power of two that can hold all the entries)
+     * @return true the entries were moved
+     * @return false the derived class could not provide the memory (nothing changed)
+     */
+    bool rehash(size_t newCapacity)
+    {
+        Entry* newEntries = nullptr;
+        bool*  newUsed    = nullptr;
+
+        if (!derived().allocate(newCapacity, newEntries, newUsed))
+        {
+            return false;
+        }
+
+        Entry* oldEntries  = m_entries;
+        bool*  oldUsed     = m_used;
+        size_t oldCapacity = m_capacity;
+
+        m_entries  = newEntries;
+        m_used     = newUsed;
+        m_capacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; i++)
+        {
+            if (oldUsed[i])
+            {
+                size_t index = findFreeIndex(oldEntries[i].key);
+                new(&m_entries[index]) Entry(move(oldEntries[i]));
+                m_used[index] = true;
+                oldEntries[i].~Entry();
+            }
+        }
+
+        derived().deallocate(oldEntries, oldUsed, oldCapacity);
+        return true;
+    }
+
+    Entry* m_entries;      ///< slots of the entries (only the used ones are constructed)
+    bool*  m_used;         ///< which slots hold an entry
+    size_t m_capacity;     ///< number of slots (zero or a power of two)
+    size_t m_size = 0;     ///< number of entries
+
+private:
+    /**
+     * @brief Get the derived class (for the memory management functions)
+     *
+     * @return Derived& reference to the derived map
+     */
+    Derived& derived()
+    {
+        return static_cast<Derived&>(*this);
+    }
+
+    /**
+     * @brief Add an entry or replace its value
+     *
+     * @tparam Arg type of the value (no need to manually type)
+     * @param key key of the entry
+     * @param value value of the entry (copied or moved)
+     * @return V* pointer to the value in the map, nullptr if the map is full
+     */
+    template<typename Arg>
+    V* emplace(const K& key, Arg&& value)
+    {
+        size_t index = findIndex(key);
+
+        if (index < m_capacity)
+        {
+            m_entries[index].value = forward<Arg>(value);
+            return &m_entries[index].value;
+        }
+
+        size_t newCapacity = derived().getGrowth(m_size + 1);
+
+        if (newCapacity != m_capacity)
+        {
+            // if the memory cannot be allocated, keep filling the current slots past the maximum load
+            rehash(newCapacity);
+        }
+
+        if (m_size >= m_capacity)
+        {
+            // error: the map is full
+            return nullptr;
+        }
+
+        index = findFreeIndex(key);
+        new(&m_entries[index]) Entry(key, forward<Arg>(value));
+        m_used[index] = true;
+        m_size++;
+        return &m_entries[index].value;
+    }
+
+    /**
+     * @brief Find the slot of a key
+     *
+     * @param key key to look for
+     * @return size_t index of the slot, m_capacity if the key is not in the map
+     */
+    size_t findIndex(const K& key) const
+    {
+        if (m_size == 0)
+        {
+            return m_capacity;
+        }
+
+        size_t mask = m_capacity - 1;
+        size_t index = H::hash(key) & mask;
+
+        for (size_t probes = 0; probes < m_capacity && m_used[index]; probes++)
+        {
+            if (H::equal(m_entries[index].key, key))
+            {
+                return index;
+            }
+
+            index = (index + 1) & mask;
+        }
+
+        return m_capacity;
+    }
+
+    /**
+     * @brief Find the first free slot for a key (the map must not be full)
+     *
+     * @param key key of the new entry
+     * @return size_t index of the slot
+     */
+    size_t findFreeIndex(const K& key) const
+    {
+        size_t mask = m_capacity - 1;
+        size_t index = H::hash(key) & mask;
+
+        while (m_used[index])
+        {
+            index = (index + 1) & mask;
+        }
+
+        return index;
+    }
+};
+
+} // namespace priv
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_HASH_MAP_BASE_H_
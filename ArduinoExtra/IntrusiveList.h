@@ -0,0 +1,643 @@
+/**
+ * @file IntrusiveList.h
+ * @author Eliot Fondere
+ * @brief Doubly-Linked List whose links are stored inside the elements (no allocation)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * The list does not own its elements, it only links objects that live elsewhere (globals, members
+ * of other objects, elements of a Pool...). Adding and removing an element is O(1) and never
+ * allocates, and an element removes itself from its list when it is destroyed.
+ *
+ * Example Usage:
+ * @code
+ * class Motor
+ * {
+ * public:
+ *     Motor(int pin);
+ *     void update();
+ *
+ *     aex::ListHook hook; // link used by the list of motors
+ * };
+ *
+ * aex::IntrusiveList<Motor, &Motor::hook> motors;
+ * Motor left(3);
+ * Motor right(5);
+ *
+ * void setup()
+ * {
+ *     motors.pushBack(left);
+ *     motors.pushBack(right);
+ * }
+ *
+ * void loop()
+ * {
+ *     for (Motor& motor : motors)
+ *     {
+ *         motor.update();
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_INTRUSIVE_LIST_H_
+#define _INCLUDE_AEX_INTRUSIVE_LIST_H_
+
+#include "utils.h"
+
+namespace aex
+{
+
+class ListHook;
+
+template<typename T, ListHook T::*Hook>
+class IntrusiveList;
+
+/**
+ * @brief Link stored inside an object so it can be part of an IntrusiveList
+ *
+ * An object can be in as many lists at the same time as it has hooks, but a hook can only be in
+ * one list at a time. Copying an object does not copy its links: the copy is not in any list.
+ */
+class ListHook
+{
+public:
+    /**
+     * @brief Initialize a hook that is not in a list
+     *
+     */
+    ListHook()
+    {
+    }
+
+    /**
+     * @brief Initialize a hook that is not in a list (the links of the other hook are not copied)
+     *
+     */
+    ListHook(const ListHook&)
+    {
+    }
+
+    /**
+     * @brief Keep the current links (the links of the other hook are not copied)
+     *
+     * @return ListHook& reference to this hook
+     */
+    ListHook& operator=(const ListHook&)
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Remove the object from its list
+     *
+     */
+    ~ListHook()
+    {
+        unlink();
+    }
+
+    /**
+     * @brief Check if the object is in a list
+     *
+     * @return true the hook is linked in a list
+     * @return false the hook is not in a list
+     */
+    bool isLinked() const
+    {
+        return (m_next != nullptr);
+    }
+
+    /**
+     * @brief Remove the object from its list (nothing is done if it is not in a list)
+     *
+     */
+    void unlink()
+    {
+        if (m_next == nullptr)
+        {
+            return;
+        }
+
+        m_prev->m_next = m_next;
+        m_next->m_prev = m_prev;
+        m_prev = nullptr;
+        m_next = nullptr;
+        m_owner = nullptr;
+    }
+
+private:
+    template<typename T, ListHook T::*Hook>
+    friend class IntrusiveList;
+
+    /**
+     * @brief Link this hook right before another
+     *
+     * @param position hook that will follow this one (must be linked, or a list's root)
+     * @param owner object containing this hook
+     */
+    void linkBefore(ListHook& position, void* owner)
+    {
+        m_owner = owner;
+        m_prev = position.m_prev;
+        m_next = &position;
+        m_prev->m_next = this;
+        position.m_prev = this;
+    }
+
+    ListHook* m_prev = nullptr; ///< previous hook in the list (nullptr if not linked)
+    ListHook* m_next = nullptr; ///< next hook in the list (nullptr if not linked)
+    void* m_owner = nullptr;    ///< object containing the hook, as given by the list (nullptr if not linked)
+};
+
+namespace priv
+{
+
+/**
+ * @brief Iterator over the elements of an IntrusiveList
+ *
+ * @tparam T type of the elements (const for read-only iterators)
+ * @tparam List list class (converts between hooks and elements)
+ */
+template<typename T, typename List>
+class IntrusiveListIterator
+{
+public:
+    /**
+     * @brief Create an iterator pointing to an element
+     *
+     * @param hook hook of the element (the list's root for the end)
+     */
+    explicit IntrusiveListIterator(const ListHook* hook)
+    : m_hook(hook)
+    {
+    }
+
+    /**
+     * @brief Get the element
+     *
+     * @return T& reference to the element
+     */
+    T& operator*() const
+    {
+        return *List::fromHook(m_hook);
+    }
+
+    /**
+     * @brief Access a member of the element
+     *
+     * @return T* pointer to the element
+     */
+    T* operator->() const
+    {
+        return List::fromHook(m_hook);
+    }
+
+    /**
+     * @brief Move to the next element
+     *
+     * @return IntrusiveListIterator& reference to this iterator
+     */
+    IntrusiveListIterator& operator++()
+    {
+        m_hook = List::next(m_hook);
+        return *this;
+    }
+
+    /**
+     * @brief Move to the previous element
+     *
+     * @return IntrusiveListIterator& reference to this iterator
+     */
+    IntrusiveListIterator& operator--()
+    {
+        m_hook = List::prev(m_hook);
+        return *this;
+    }
+
+    /**
+     * @brief Compare the position of two iterators
+     *
+     * @param other iterator to compare with
+     * @return true the iterators point to the same element
+     * @return false the iterators point to different elements
+     */
+    bool operator==(const IntrusiveListIterator& other) const
+    {
+        return (m_hook == other.m_hook);
+    }
+
+    /**
+     * @brief Compare the position of two iterators
+     *
+     * @param other iterator to compare with
+     * @return true the iterators point to different elements
+     * @return false the iterators point to the same element
+     */
+    bool operator!=(const IntrusiveListIterator& other) const
+    {
+        return (m_hook != other.m_hook);
+    }
+
+private:
+    template<typename U, ListHook U::*Hook>
+    friend class aex::IntrusiveList;
+
+    const ListHook* m_hook; ///< hook of the element
+};
+
+} // namespace priv
+
+/**
+ * @brief Circular doubly-linked list of objects linked through one of their ListHook members
+ *
+ * @tparam T type of the elements
+ * @tparam Hook ListHook member of T used as the link (&T::hook)
+ *
+ * The list starts and ends at a root hook stored in the list itself, so adding and removing never
+ * needs to check for the ends. The list cannot be copied since a hook can only be in one list.
+ */
+template<typename T, ListHook T::*Hook>
+class IntrusiveList
+{
+public:
+    typedef priv::IntrusiveListIterator<T, IntrusiveList>       iterator;       ///< iterator over the elements
+    typedef priv::IntrusiveListIterator<const T, IntrusiveList> const_iterator; ///< read-only iterator over the elements
+
+    /**
+     * @brief Initialize an empty list
+     *
+     */
+    IntrusiveList()
+    {
+        m_root.m_prev = &m_root;
+        m_root.m_next = &m_root;
+    }
+
+    IntrusiveList(const IntrusiveList&) = delete;            ///< an object can only be in one list per hook
+    IntrusiveList& operator=(const IntrusiveList&) = delete; ///< an object can only be in one list per hook
+
+    /**
+     * @brief Initialize a list by taking the elements of another
+     *
+     * @param other list to move (left empty)
+     */
+    IntrusiveList(IntrusiveList&& other)
+    : IntrusiveList()
+    {
+        takeFrom(other);
+    }
+
+    /**
+     * @brief Replace the elements by the elements of another list
+     *
+     * @param other list to move (left empty)
+     * @return IntrusiveList& reference to this list
+     */
+    IntrusiveList& operator=(IntrusiveList&& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            takeFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Remove all the elements (they are not destroyed)
+     *
+     */
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+    /**
+     * @brief Add an element to the front of the list
+     *
+     * @param element element to add (removed from its current list first)
+     */
+    void pushFront(T& element)
+    {
+        insertBefore(*m_root.m_next, element);
+    }
+
+    /**
+     * @brief Add an element to the back of the list
+     *
+     * @param element element to add (removed from its current list first)
+     */
+    void pushBack(T& element)
+    {
+        insertBefore(m_root, element);
+    }
+
+    /**
+     * @brief Add an element before another
+     *
+     * @param position iterator to the element that will follow the new one (end() to add at the back)
+     * @param element element to add (removed from its current list first)
+     * @return iterator iterator to the new element
+     */
+    iterator insert(iterator position, T& element)
+    {
+        insertBefore(*const_cast<ListHook*>(position.m_hook), element);
+        return iterator(&(element.*Hook));
+    }
+
+    /**
+     * @brief Remove the first element (nothing is done if the list is empty)
+     *
+     * @return T* pointer to the removed element, nullptr if the list was empty
+     */
+    T* popFront()
+    {
+        if (isEmpty())
+        {
+            return nullptr;
+        }
+
+        T* element = fromHook(m_root.m_next);
+        m_root.m_next->unlink();
+        return element;
+    }
+
+    /**
+     * @brief Remove the last element (nothing is done if the list is empty)
+     *
+     * @return T* pointer to the removed element, nullptr if the list was empty
+     */
+    T* popBack()
+    {
+        if (isEmpty())
+        {
+            return nullptr;
+        }
+
+        T* element = fromHook(m_root.m_prev);
+        m_root.m_prev->unlink();
+        return element;
+    }
+
+    /**
+     * @brief Remove an element from the list
+     *
+     * @param element element to remove (must be in this list or in no list)
+     *
+     * Same as calling unlink() on the element's hook. It does not need the list, so elements can
+     * remove themselves (in their destructor for example).
+     */
+    static void remove(T& element)
+    {
+        (element.*Hook).unlink();
+    }
+
+    /**
+     * @brief Remove the element an iterator points to
+     *
+     * @param position iterator to the element (must not be end())
+     * @return iterator iterator to the element after the removed one (allows removing while iterating)
+     */
+    iterator erase(iterator position)
+    {
+        iterator following(position.m_hook->m_next);
+        const_cast<ListHook*>(position.m_hook)->unlink();
+        return following;
+    }
+
+    /**
+     * @brief Remove all the elements that satisfy a condition
+     *
+     * @tparam Predicate type of the condition (no need to manually type)
+     * @param predicate function returning true for the elements to remove
+     * @return size_t amount of elements removed
+     */
+    template<typename Predicate>
+    size_t removeIf(Predicate predicate)
+    {
+        size_t removed = 0;
+
+        for (iterator it = begin(); it != end();)
+        {
+            if (predicate(*it))
+            {
+                it = erase(it);
+                removed++;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        return removed;
+    }
+
+    /**
+     * @brief Remove all the elements (they are not destroyed)
+     *
+     */
+    void clear()
+    {
+        while (m_root.m_next != &m_root)
+        {
+            m_root.m_next->unlink();
+        }
+    }
+
+    /**
+     * @brief Get the first element
+     *
+     * @return T& reference to the first element (the list must not be empty)
+     */
+    T& front()
+    {
+        return *fromHook(m_root.m_next);
+    }
+
+    /**
+     * @brief Get the first element
+     *
+     * @return const T& reference to the first element (the list must not be empty)
+     */
+    const T& front() const
+    {
+        return *fromHook(m_root.m_next);
+    }
+
+    /**
+     * @brief Get the last element
+     *
+     * @return T& reference to the last element (the list must not be empty)
+     */
+    T& back()
+    {
+        return *fromHook(m_root.m_prev);
+    }
+
+    /**
+     * @brief Get the last element
+     *
+     * @return const T& reference to the last element (the list must not be empty)
+     */
+    const T& back() const
+    {
+        return *fromHook(m_root.m_prev);
+    }
+
+    /**
+     * @brief Check if the list is empty
+     *
+     * @return true list is empty
+     * @return false list is not empty
+     */
+    bool isEmpty() const
+    {
+        return (m_root.m_next == &m_root);
+    }
+
+    /**
+     * @brief Count the elements of the list
+     *
+     * @return size_t amount of elements
+     *
+     * Note: the size is not stored (elements can unlink themselves), so this walks the whole list
+     */
+    size_t getSize() const
+    {
+        size_t size = 0;
+
+        for (const ListHook* hook = m_root.m_next; hook != &m_root; hook = hook->m_next)
+        {
+            size++;
+        }
+
+        return size;
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     *
+     * @return iterator iterator to the first element
+     */
+    iterator begin()
+    {
+        return iterator(m_root.m_next);
+    }
+
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     *
+     * @return iterator iterator past the last element
+     */
+    iterator end()
+    {
+        return iterator(&m_root);
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     *
+     * @return const_iterator read-only iterator to the first element
+     */
+    const_iterator begin() const
+    {
+        return const_iterator(m_root.m_next);
+    }
+
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     *
+     * @return const_iterator read-only iterator past the last element
+     */
+    const_iterator end() const
+    {
+        return const_iterator(&m_root);
+    }
+
+private:
+    template<typename U, typename List>
+    friend class priv::IntrusiveListIterator;
+
+    /**
+     * @brief Link an element before a hook
+     *
+     * @param position hook that will follow the element
+     * @param element element to link (removed from its current list first)
+     */
+    void insertBefore(ListHook& position, T& element)
+    {
+        ListHook& hook = element.*Hook;
+
+        if (&hook == &position)
+        {
+            return;
+        }
+
+        hook.unlink();
+        hook.linkBefore(position, &element);
+    }
+
+    /**
+     * @brief Take all the elements of another list
+     *
+     * @param other list to take the elements from (must be empty on this side)
+     */
+    void takeFrom(IntrusiveList& other)
+    {
+        if (other.isEmpty())
+        {
+            return;
+        }
+
+        m_root.m_next = other.m_root.m_next;
+        m_root.m_prev = other.m_root.m_prev;
+        m_root.m_next->m_prev = &m_root;
+        m_root.m_prev->m_next = &m_root;
+        other.m_root.m_next = &other.m_root;
+        other.m_root.m_prev = &other.m_root;
+    }
+
+    /**
+     * @brief Get the hook after another
+     *
+     * @param hook current hook
+     * @return const ListHook* next hook
+     */
+    static const ListHook* next(const ListHook* hook)
+    {
+        return hook->m_next;
+    }
+
+    /**
+     * @brief Get the hook before another
+     *
+     * @param hook current hook
+     * @return const ListHook* previous hook
+     */
+    static const ListHook* prev(const ListHook* hook)
+    {
+        return hook->m_prev;
+    }
+
+    /**
+     * @brief Get the element containing a hook
+     *
+     * @param hook hook of the element (must not be the root)
+     * @return T* pointer to the element
+     */
+    static T* fromHook(const ListHook* hook)
+    {
+        // the list stores the element in the hook when linking it, which works for any T (virtual
+        // or multiple bases included)
+        return static_cast<T*>(hook->m_owner);
+    }
+
+    ListHook m_root; ///< root of the circular list (m_root.m_next is the first element)
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_INTRUSIVE_LIST_H_
@@ -0,0 +1,241 @@
+/**
+ * @file Memory.h
+ * @author Eliot Fondere
+ * @brief Helpers to construct, move and destroy ranges of elements in raw memory
+ * 
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ * 
+ * Used by the containers to manage their elements. Trivial types are handled with a single
+ * memcpy and no destructor calls.
+ */
+
+#ifndef _INCLUDE_AEX_MEMORY_H_
+#define _INCLUDE_AEX_MEMORY_H_
+
+#include "utils.h"
+#include <new>
+#include <string.h>
+
+namespace aex
+{
+
+namespace priv
+{
+
+/**
+ * @brief Types with the strictest alignment an object can reasonably require
+ * 
+ * Used to align raw buffers that can hold objects of any type.
+ */
+union MaxAlign
+{
+    void*       objectPtr;
+    void      (*functionPtr)();
+    long long   integer;
+    double      floating;
+};
+
+/**
+ * @brief Uninitialized memory for N elements stored inside a container
+ * 
+ * @tparam T type of the elements
+ * @tparam N amount of elements
+ * 
+ * Base classes are initialized in the order they are declared, so a container inheriting from
+ * this before its other bases can pass inlineData() to their constructors. A member of the
+ * container itself would not exist yet at that point.
+ */
+template<typename T, size_t N>
+struct InlineStorage
+{
+    /**
+     * @brief Get a pointer to the inline storage
+     * 
+     * @return T* pointer to the first inline element
+     */
+    T* inlineData()
+    {
+        return reinterpret_cast<T*>(m_storage);
+    }
+
+    /**
+     * @brief Get a pointer to the inline storage
+     * 
+     * @return const T* pointer to the first inline element (read only)
+     */
+    const T* inlineData() const
+    {
+        return reinterpret_cast<const T*>(m_storage);
+    }
+
+    alignas(T) unsigned char m_storage[N * sizeof(T)]; ///< uninitialized memory for the elements
+};
+
+/**
+ * @brief Destroy a range of elements
+ * 
+ * @tparam T type of the elements
+ * @param first pointer to the first element
+ * @param count number of elements to destroy
+ */
+template<typename T>
+void destroyRange(T* first, size_t count)
+{
+    if (is_trivially_destructible<T>::value)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        first[i].~T();
+    }
+}
+
+/**
+ * @brief Move a range of elements to uninitialized memory and destroy the originals
+ * 
+ * @tparam T type of the elements
+ * @param destination pointer to the (uninitialized) destination memory
+ * @param source pointer to the first element to move
+ * @param count number of elements to move
+ * 
+ * Note: the source and destination ranges must not overlap
+ */
+template<typename T>
+void relocateRange(T* destination, T* source, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (is_trivially_relocatable<T>::value)
+    {
+        memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        new(&destination[i]) T(move(source[i])); // create in place
+    }
+
+    destroyRange(source, count);
+}
+
+/**
+ * @brief Move a range of elements to a position overlapping their current one (used to shift
+ * elements inside a container)
+ * 
+ * @tparam T type of the elements
+ * @param destination pointer to the destination (slots not overlapping the source must be
+ * uninitialized or already destroyed)
+ * @param source pointer to the first element to move
+ * @param count number of elements to move
+ * 
+ * The source slots not covered by the destination are left destroyed. Trivially relocatable
+ * types are moved with a single memmove.
+ */
+template<typename T>
+void relocateOverlapping(T* destination, T* source, size_t count)
+{
+    if (count == 0 || destination == source)
+    {
+        return;
+    }
+
+    if (is_trivially_relocatable<T>::value)
+    {
+        memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+        return;
+    }
+
+    if (destination < source)
+    {
+        // shifting down: start with the first element so no element is overwritten before it moves
+        for (size_t i = 0; i < count; i++)
+        {
+            new(&destination[i]) T(move(source[i])); // create in place
+            source[i].~T();
+        }
+    }
+    else
+    {
+        // shifting up: start with the last element
+        for (size_t i = count; i > 0; i--)
+        {
+            new(&destination[i - 1]) T(move(source[i - 1])); // create in place
+            source[i - 1].~T();
+        }
+    }
+}
+
+/**
+ * @brief Copy a range of elements to uninitialized memory
+ * 
+ * @tparam T type of the elements
+ * @param destination pointer to the (uninitialized) destination memory
+ * @param source pointer to the first element to copy
+ * @param count number of elements to copy
+ * 
+ * Note: the source and destination ranges must not overlap
+ */
+template<typename T>
+void copyRange(T* destination, const T* source, size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (is_trivially_copyable<T>::value)
+    {
+        memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        new(&destination[i]) T(source[i]); // create in place
+    }
+}
+
+/**
+ * @brief Construct copies of a value in uninitialized memory
+ * 
+ * @tparam T type of the elements
+ * @param destination pointer to the (uninitialized) destination memory
+ * @param count number of copies
+ * @param value value to copy
+ */
+template<typename T>
+void fillRange(T* destination, size_t count, const T& value)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        new(&destination[i]) T(value); // create in place
+    }
+}
+
+/**
+ * @brief Default construct elements in uninitialized memory
+ * 
+ * @tparam T type of the elements
+ * @param destination pointer to the (uninitialized) destination memory
+ * @param count number of elements to construct
+ */
+template<typename T>
+void constructRange(T* destination, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        new(&destination[i]) T(); // create in place
+    }
+}
+
+} // namespace priv
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_MEMORY_H_
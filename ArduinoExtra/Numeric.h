@@ -0,0 +1,357 @@
+/**
+ * @file Numeric.h
+ * @author Eliot Fondere
+ * @brief Unrolled numeric kernels (dot product, axpy, sum, min/max, convolution) over Arrays
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * The size of an Array is known at compile time, so these kernels are unrolled by 4 (with the
+ * remainder unrolled completely) and use several accumulators to keep the processor's pipeline
+ * busy. On processors with the ARM DSP extension (Cortex-M4/M7, e.g. Teensy 3/4), dot products
+ * and convolutions of int16_t use the SMLAD instructions (two multiply-accumulates per cycle).
+ *
+ * Results of small integer types are accumulated in 32 bits (see Accumulator) so they do not
+ * overflow. float, Fixed and 32-bit integers are accumulated in their own type.
+ *
+ * Example Usage:
+ * @code
+ * aex::Array<int16_t, 32> samples;
+ * const aex::Array<int16_t, 5> lowPass = {{ 1, 4, 6, 4, 1 }};
+ * aex::Array<int32_t, 28> filtered;
+ *
+ * aex::convolve(samples, lowPass, filtered); // FIR filter
+ * int32_t energy = aex::dot(samples, samples);
+ *
+ * aex::Array<float, 3> velocity = {{ 0.0f, 0.0f, 0.0f }};
+ * aex::Array<float, 3> acceleration = {{ 0.1f, 0.0f, -9.8f }};
+ * aex::axpy(0.01f, acceleration, velocity); // velocity += 0.01 * acceleration
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_NUMERIC_H_
+#define _INCLUDE_AEX_NUMERIC_H_
+
+#include "utils.h"
+#include "Array.h"
+#include <stdint.h>
+#include <string.h>
+
+namespace aex
+{
+
+/**
+ * @brief Type in which the kernels accumulate results (products and sums) of a given type
+ *
+ * @tparam T type of the elements
+ *
+ * Specialize it to accumulate another type differently (e.g. int32_t in int64_t).
+ */
+template<typename T>
+struct Accumulator
+{
+    typedef T type;
+};
+
+template<> struct Accumulator<int8_t>   { typedef int32_t type; };  ///< @see Accumulator
+template<> struct Accumulator<uint8_t>  { typedef uint32_t type; }; ///< @see Accumulator
+template<> struct Accumulator<int16_t>  { typedef int32_t type; };  ///< @see Accumulator
+template<> struct Accumulator<uint16_t> { typedef uint32_t type; }; ///< @see Accumulator
+
+namespace priv
+{
+
+/**
+ * @brief Call a function with N consecutive indices, unrolled at compile time
+ *
+ * @tparam N number of calls
+ */
+template<size_t N>
+struct Unroll
+{
+    template<typename F>
+    static void apply(F& function, size_t index)
+    {
+        function(index);
+        Unroll<N - 1>::apply(function, index + 1);
+    }
+};
+
+/**
+ * @brief End of the unrolled calls
+ */
+template<>
+struct Unroll<0>
+{
+    template<typename F>
+    static void apply(F&, size_t)
+    {
+    }
+};
+
+/**
+ * @brief Call a function with the indices 0 to N - 1, 4 at a time and the remainder unrolled
+ *
+ * @tparam N number of indices
+ * @tparam F type of the function (no need to manually type)
+ * @param function called with every index
+ */
+template<size_t N, typename F>
+inline void unrolledFor(F& function)
+{
+    for (size_t i = 0; i + 4 <= N; i += 4)
+    {
+        Unroll<4>::apply(function, i);
+    }
+
+    Unroll<N % 4>::apply(function, N - N % 4);
+}
+
+/**
+ * @brief Sum of the products a[i] * b[direction * i] for i from 0 to N - 1
+ *
+ * @tparam N number of products
+ * @tparam T type of the elements
+ * @tparam Reversed walk b backwards (for convolutions)
+ */
+template<size_t N, typename T, bool Reversed>
+struct DotKernel
+{
+    typedef typename Accumulator<T>::type R;
+
+    static R run(const T* a, const T* b)
+    {
+        // one accumulator per unrolled product so they do not wait for each other
+        R accumulators[4] = {R(0), R(0), R(0), R(0)};
+
+        auto multiplyAdd = [&](size_t i) -> void
+        {
+            accumulators[i % 4] += R(a[i]) * R(Reversed ? *(b - i) : b[i]);
+        };
+
+        unrolledFor<N>(multiplyAdd);
+        return (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+    }
+};
+
+#if defined(__ARM_FEATURE_DSP)
+/**
+ * @brief Dual 16-bit multiply-accumulate: accumulator + a.low * b.low + a.high * b.high
+ */
+inline int32_t smlad(uint32_t a, uint32_t b, int32_t accumulator)
+{
+    int32_t result;
+    __asm__("smlad %0, %1, %2, %3" : "=r"(result) : "r"(a), "r"(b), "r"(accumulator));
+    return result;
+}
+
+/**
+ * @brief Dual 16-bit multiply-accumulate exchanged: accumulator + a.low * b.high + a.high * b.low
+ */
+inline int32_t smladx(uint32_t a, uint32_t b, int32_t accumulator)
+{
+    int32_t result;
+    __asm__("smladx %0, %1, %2, %3" : "=r"(result) : "r"(a), "r"(b), "r"(accumulator));
+    return result;
+}
+
+/**
+ * @brief Read two consecutive int16_t as one 32-bit word (unaligned reads are fine on Cortex-M4)
+ */
+inline uint32_t readPair(const int16_t* address)
+{
+    uint32_t pair;
+    memcpy(&pair, address, sizeof(pair));
+    return pair;
+}
+
+/**
+ * @brief DotKernel for int16_t using the DSP instructions (two products per instruction)
+ *
+ * @see DotKernel
+ */
+template<size_t N, bool Reversed>
+struct DotKernel<N, int16_t, Reversed>
+{
+    static int32_t run(const int16_t* a, const int16_t* b)
+    {
+        int32_t accumulators[2] = {0, 0};
+
+        auto multiplyAdd = [&](size_t pair) -> void
+        {
+            size_t i = 2 * pair;
+
+            // the pair of b walked backwards is (b[-i - 1], b[-i]) in memory, so its halves are exchanged
+            accumulators[pair % 2] = Reversed ? smladx(readPair(a + i), readPair(b - i - 1), accumulators[pair % 2])
+                                              : smlad(readPair(a + i), readPair(b + i), accumulators[pair % 2]);
+        };
+
+        unrolledFor<N / 2>(multiplyAdd);
+
+        if (N % 2 != 0)
+        {
+            accumulators[0] += int32_t(a[N - 1]) * (Reversed ? *(b - (N - 1)) : b[N - 1]);
+        }
+
+        return accumulators[0] + accumulators[1];
+    }
+};
+#endif
+
+} // namespace priv
+
+/**
+ * @brief Dot product of two arrays (sum of the products of their elements)
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the arrays (no need to manually type)
+ * @param a first array
+ * @param b second array
+ * @return Accumulator<T>::type sum of a[i] * b[i]
+ */
+template<typename T, size_t S>
+typename Accumulator<T>::type dot(const Array<T, S>& a, const Array<T, S>& b)
+{
+    return priv::DotKernel<S, T, false>::run(a.data(), b.data());
+}
+
+/**
+ * @brief Sum of the elements of an array
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the array (no need to manually type)
+ * @param a array
+ * @return Accumulator<T>::type sum of the elements
+ */
+template<typename T, size_t S>
+typename Accumulator<T>::type sum(const Array<T, S>& a)
+{
+    typedef typename Accumulator<T>::type R;
+    R accumulators[4] = {R(0), R(0), R(0), R(0)};
+
+    auto add = [&](size_t i) -> void
+    {
+        accumulators[i % 4] += R(a[i]);
+    };
+
+    priv::unrolledFor<S>(add);
+    return (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+}
+
+/**
+ * @brief Add a scaled array to another: y = alpha * x + y
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the arrays (no need to manually type)
+ * @param alpha factor applied to x
+ * @param x array to scale and add
+ * @param y array to add to (modified in place)
+ */
+template<typename T, size_t S>
+void axpy(const T& alpha, const Array<T, S>& x, Array<T, S>& y)
+{
+    auto multiplyAdd = [&](size_t i) -> void
+    {
+        y[i] = static_cast<T>(alpha * x[i] + y[i]);
+    };
+
+    priv::unrolledFor<S>(multiplyAdd);
+}
+
+/**
+ * @brief Add two arrays element by element
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the arrays (no need to manually type)
+ * @param a first array
+ * @param b second array
+ * @param result where a[i] + b[i] is stored (can be a or b)
+ */
+template<typename T, size_t S>
+void add(const Array<T, S>& a, const Array<T, S>& b, Array<T, S>& result)
+{
+    auto addElements = [&](size_t i) -> void
+    {
+        result[i] = static_cast<T>(a[i] + b[i]);
+    };
+
+    priv::unrolledFor<S>(addElements);
+}
+
+/**
+ * @brief Multiply all the elements of an array by the same factor
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the array (no need to manually type)
+ * @param a array to scale (modified in place)
+ * @param factor factor applied to every element
+ */
+template<typename T, size_t S>
+void scale(Array<T, S>& a, const T& factor)
+{
+    auto multiply = [&](size_t i) -> void
+    {
+        a[i] = static_cast<T>(a[i] * factor);
+    };
+
+    priv::unrolledFor<S>(multiply);
+}
+
+/**
+ * @brief Find the smallest and biggest elements of an array in a single pass
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the array (no need to manually type)
+ * @param a array
+ * @param minimum where the smallest element is copied
+ * @param maximum where the biggest element is copied
+ */
+template<typename T, size_t S>
+void minMax(const Array<T, S>& a, T& minimum, T& maximum)
+{
+    static_assert(S > 0, "minMax needs at least one element");
+
+    T smallest = a[0];
+    T biggest = a[0];
+
+    auto compare = [&](size_t i) -> void
+    {
+        if (a[i] < smallest)
+        {
+            smallest = a[i];
+        }
+
+        if (biggest < a[i])
+        {
+            biggest = a[i];
+        }
+    };
+
+    priv::unrolledFor<S>(compare);
+    minimum = smallest;
+    maximum = biggest;
+}
+
+/**
+ * @brief Convolve a signal with a kernel (FIR filter), keeping only the fully overlapping outputs
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam S size of the signal (no need to manually type)
+ * @tparam K size of the kernel (no need to manually type)
+ * @param signal input samples
+ * @param kernel filter coefficients
+ * @param output where output[i] = sum of signal[i + k] * kernel[K - 1 - k] is stored
+ */
+template<typename T, size_t S, size_t K>
+void convolve(const Array<T, S>& signal, const Array<T, K>& kernel, Array<typename Accumulator<T>::type, S - K + 1>& output)
+{
+    static_assert(K > 0 && K <= S, "the kernel must not be longer than the signal");
+
+    for (size_t i = 0; i < S - K + 1; i++)
+    {
+        output[i] = priv::DotKernel<K, T, true>::run(signal.data() + i, kernel.data() + (K - 1));
+    }
+}
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_NUMERIC_H_
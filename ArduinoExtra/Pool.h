@@ -0,0 +1,205 @@
+/**
+ * @file Pool.h
+ * @author Eliot Fondere
+ * @brief Fixed-Block Memory Pool and its allocator adapter
+ * 
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ * 
+ * Example Usage:
+ * @code
+ * aex::Pool<32, 16> callbackPool; // 16 blocks of 32 bytes, allocated once (not on the heap)
+ * using CallbackAllocator = aex::PoolAllocator<decltype(callbackPool), callbackPool>;
+ *
+ * aex::Vector<int, aex::GrowthNever, CallbackAllocator> values; // takes one block
+ *
+ * void setup()
+ * {
+ *     values.reserve(8); // 8 * sizeof(int) must fit in a block
+ *
+ *     // callables too large for the inline buffer of Function take one block
+ *     aex::Function<void(), CallbackAllocator> callback([]() -> void { Serial.println("tick"); });
+ *     callback();
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_POOL_H_
+#define _INCLUDE_AEX_POOL_H_
+
+#include "Memory.h"
+
+namespace aex
+{
+
+/**
+ * @brief Memory pool handing out blocks of a fixed size in constant time
+ * 
+ * @tparam BlockSize size of a block in bytes (the largest allocation the pool accepts)
+ * @tparam Count number of blocks in the pool
+ * 
+ * The blocks are stored inside the pool and free blocks are kept in a linked list, so allocating
+ * and freeing is O(1) and the memory never fragments. The pool is not interrupt safe.
+ */
+template<size_t BlockSize, size_t Count>
+class Pool
+{
+public:
+    static_assert(BlockSize > 0 && Count > 0, "Pool needs at least one block of at least one byte");
+
+    /**
+     * @brief Initialize the pool with all blocks free
+     * 
+     */
+    Pool()
+    {
+        for (size_t i = 0; i + 1 < Count; i++)
+        {
+            m_blocks[i].next = &m_blocks[i + 1];
+        }
+
+        m_blocks[Count - 1].next = nullptr;
+        m_freeList = &m_blocks[0];
+    }
+
+    Pool(const Pool&) = delete;            ///< blocks given by the pool must stay where they are
+    Pool& operator=(const Pool&) = delete; ///< blocks given by the pool must stay where they are
+
+    /**
+     * @brief Take a free block from the pool
+     * 
+     * @param size amount of bytes needed
+     * @return void* pointer to the block (nullptr if size is larger than a block or the pool is empty)
+     */
+    void* allocate(size_t size)
+    {
+        if (size > BlockSize || m_freeList == nullptr)
+        {
+            // error: allocation too large or pool exhausted
+            return nullptr;
+        }
+
+        Block* block = m_freeList;
+        m_freeList = block->next;
+        m_freeCount--;
+
+        return block;
+    }
+
+    /**
+     * @brief Give a block back to the pool
+     * 
+     * @param ptr pointer to the block (returned by allocate(), nothing is done for nullptr)
+     * @param size size of the allocation (unused, kept for compatibility with allocators)
+     */
+    void deallocate(void* ptr, size_t size)
+    {
+        (void)size;
+
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        Block* block = static_cast<Block*>(ptr);
+        block->next = m_freeList;
+        m_freeList = block;
+        m_freeCount++;
+    }
+
+    /**
+     * @brief Check if a pointer points to a block of this pool
+     * 
+     * @param ptr pointer to check
+     * @return true the pointer is a block of this pool
+     * @return false the pointer comes from somewhere else
+     */
+    bool owns(const void* ptr) const
+    {
+        const Block* block = static_cast<const Block*>(ptr);
+        return (block >= &m_blocks[0] && block < &m_blocks[Count]);
+    }
+
+    /**
+     * @brief Get the amount of free blocks
+     * 
+     * @return size_t number of blocks that can still be allocated
+     */
+    size_t getFreeCount() const
+    {
+        return m_freeCount;
+    }
+
+    /**
+     * @brief Get the size of a block
+     * 
+     * @return size_t size of a block in bytes
+     */
+    static constexpr size_t getBlockSize()
+    {
+        return BlockSize;
+    }
+
+    /**
+     * @brief Get the total amount of blocks
+     * 
+     * @return size_t number of blocks in the pool
+     */
+    static constexpr size_t getBlockCount()
+    {
+        return Count;
+    }
+
+private:
+    /**
+     * @brief A block of memory, holding the pointer to the next free block while it is free
+     * 
+     */
+    union Block
+    {
+        Block*         next;            ///< next free block (only while the block is free)
+        priv::MaxAlign alignment;       ///< align the blocks for any type
+        unsigned char  data[BlockSize]; ///< memory given to the user
+    };
+
+    Block  m_blocks[Count];      ///< all the blocks of the pool
+    Block* m_freeList = nullptr; ///< first free block
+    size_t m_freeCount = Count;  ///< number of free blocks
+};
+
+/**
+ * @brief Allocator taking its memory from a Pool object
+ * 
+ * @tparam PoolType type of the pool (use decltype(pool))
+ * @tparam pool pool object (must be a global or static variable)
+ * 
+ * @see Allocator.h
+ */
+template<typename PoolType, PoolType& pool>
+struct PoolAllocator
+{
+    /**
+     * @brief Take a block from the pool
+     * 
+     * @param size amount of bytes needed
+     * @return void* pointer to the block (nullptr if the pool cannot provide it)
+     */
+    static void* allocate(size_t size)
+    {
+        return pool.allocate(size);
+    }
+
+    /**
+     * @brief Give a block back to the pool
+     * 
+     * @param ptr pointer to the block
+     * @param size size of the allocation
+     */
+    static void deallocate(void* ptr, size_t size)
+    {
+        pool.deallocate(ptr, size);
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_POOL_H_
@@ -0,0 +1,279 @@
+/**
+ * @file Profiler.h
+ * @author Eliot Fondere
+ * @brief Opt-in measurement of how long sections of code (and scheduler tasks) take to run
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * The profiler is only compiled when AEX_PROFILING is defined before including the library.
+ * Otherwise the macros below expand to nothing, so profiled code costs no memory and no time.
+ *
+ * Example Usage:
+ * @code
+ * #define AEX_PROFILING
+ * #include <ArduinoExtra.h>
+ *
+ * void readSensors()
+ * {
+ *     AEX_PROFILE_SCOPE("readSensors"); // measures until the end of the function
+ *     // ...
+ * }
+ *
+ * void updatePid()
+ * {
+ *     AEX_PROFILE_SCOPE_BUDGET("updatePid", 500); // also counts the runs longer than 500 us
+ *     // ...
+ * }
+ *
+ * void loop()
+ * {
+ *     readSensors();
+ *     updatePid();
+ *
+ *     if (Serial.available())
+ *     {
+ *         Serial.read();
+ *         AEX_PROFILE_DUMP(Serial); // prints one line per profiled section
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_PROFILER_H_
+#define _INCLUDE_AEX_PROFILER_H_
+
+/**
+ * @brief Maximum amount of profiled sections (and tasks)
+ *
+ * Sections profiled once the table is full are ignored. Define this macro before including the
+ * library to change it.
+ */
+#ifndef AEX_PROFILER_SIZE
+#define AEX_PROFILER_SIZE 16
+#endif
+
+#ifdef AEX_PROFILING
+
+#include "utils.h"
+#include "StaticVector.h"
+#include <string.h>
+
+#define AEX_PRIV_CONCAT_IMPL(a, b) a##b
+#define AEX_PRIV_CONCAT(a, b) AEX_PRIV_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Measure the time until the end of the current scope
+ *
+ * @param name name of the section (a string literal)
+ */
+#define AEX_PROFILE_SCOPE(name) AEX_PROFILE_SCOPE_BUDGET(name, 0)
+
+/**
+ * @brief Measure the time until the end of the current scope and count the runs that take longer
+ * than a given time
+ *
+ * @param name name of the section (a string literal)
+ * @param budget maximum expected time in microseconds (0 for no limit)
+ */
+#define AEX_PROFILE_SCOPE_BUDGET(name, budget) \
+    static aex::ProfileEntry* AEX_PRIV_CONCAT(aexProfileEntry, __LINE__) = aex::Profiler::getEntry(name); \
+    aex::ProfileScope AEX_PRIV_CONCAT(aexProfileScope, __LINE__)(AEX_PRIV_CONCAT(aexProfileEntry, __LINE__), budget)
+
+/**
+ * @brief Print the measurements of all the profiled sections
+ *
+ * @param printer where to print (e.g. Serial)
+ */
+#define AEX_PROFILE_DUMP(printer) aex::Profiler::dump(printer)
+
+/**
+ * @brief Reset the measurements of all the profiled sections
+ */
+#define AEX_PROFILE_RESET() aex::Profiler::reset()
+
+namespace aex
+{
+
+/**
+ * @brief Measurements of a profiled section, all times are in microseconds
+ */
+struct ProfileEntry
+{
+    const char*   name;          ///< Name of the section
+    unsigned long count;         ///< Number of runs
+    unsigned long minTime;       ///< Shortest run
+    unsigned long maxTime;       ///< Longest run
+    unsigned long totalTime;     ///< Sum of all the runs (to compute the average)
+    unsigned long misses;        ///< Number of runs over budget (or skipped runs for scheduler tasks)
+
+    /**
+     * @brief Add the duration of a run
+     *
+     * @param duration how long the run took
+     */
+    void record(unsigned long duration)
+    {
+        if (count == 0 || duration < minTime)
+        {
+            minTime = duration;
+        }
+
+        if (duration > maxTime)
+        {
+            maxTime = duration;
+        }
+
+        totalTime += duration;
+        count++;
+    }
+};
+
+/**
+ * @brief Fixed-size table of the profiled sections
+ *
+ * Usually used through the AEX_PROFILE_ macros rather than directly.
+ */
+class Profiler
+{
+public:
+    /**
+     * @brief Get the entry of a profiled section, adding it to the table if needed
+     *
+     * @param name name of the section (must stay valid, a string literal for example)
+     * @return ProfileEntry* entry of the section, nullptr if the table is full
+     */
+    static ProfileEntry* getEntry(const char* name)
+    {
+        StaticVector<ProfileEntry, AEX_PROFILER_SIZE>& entries = getEntries();
+
+        for (size_t i = 0; i < entries.getSize(); i++)
+        {
+            if (entries[i].name == name || strcmp(entries[i].name, name) == 0)
+            {
+                return &entries[i];
+            }
+        }
+
+        // nullptr if there are too many profiled sections, see AEX_PROFILER_SIZE
+        ProfileEntry entry = {name, 0, 0, 0, 0, 0};
+        return entries.emplaceBack(entry);
+    }
+
+    /**
+     * @brief Print one line per profiled section: name, count, min, average, max and misses
+     *
+     * @tparam P type of the printer (no need to manually type)
+     * @param printer where to print (e.g. Serial)
+     */
+    template<typename P>
+    static void dump(P& printer)
+    {
+        const StaticVector<ProfileEntry, AEX_PROFILER_SIZE>& entries = getEntries();
+
+        printer.println("name\tcount\tmin\tavg\tmax\tmisses");
+
+        for (size_t i = 0; i < entries.getSize(); i++)
+        {
+            const ProfileEntry& entry = entries[i];
+
+            printer.print(entry.name);
+            printer.print("\t");
+            printer.print(entry.count);
+            printer.print("\t");
+            printer.print(entry.minTime);
+            printer.print("\t");
+            printer.print((entry.count > 0) ? entry.totalTime / entry.count : 0UL);
+            printer.print("\t");
+            printer.print(entry.maxTime);
+            printer.print("\t");
+            printer.println(entry.misses);
+        }
+    }
+
+    /**
+     * @brief Reset the measurements of all the sections (they stay in the table)
+     *
+     */
+    static void reset()
+    {
+        StaticVector<ProfileEntry, AEX_PROFILER_SIZE>& entries = getEntries();
+
+        for (size_t i = 0; i < entries.getSize(); i++)
+        {
+            ProfileEntry entry = {entries[i].name, 0, 0, 0, 0, 0};
+            entries[i] = entry;
+        }
+    }
+
+private:
+    /**
+     * @brief Get the table of the profiled sections
+     *
+     * @return StaticVector<ProfileEntry, AEX_PROFILER_SIZE>& the only table of the program
+     */
+    static StaticVector<ProfileEntry, AEX_PROFILER_SIZE>& getEntries()
+    {
+        static StaticVector<ProfileEntry, AEX_PROFILER_SIZE> entries;
+        return entries;
+    }
+};
+
+/**
+ * @brief Measure the time between its construction and its destruction
+ */
+class ProfileScope
+{
+public:
+    /**
+     * @brief Start measuring
+     *
+     * @param entry where the measurement is recorded (nothing is recorded for nullptr)
+     * @param budget maximum expected time in microseconds, longer runs are counted as misses (0 for
+     * no limit)
+     */
+    ProfileScope(ProfileEntry* entry, unsigned long budget = 0)
+    : m_entry(entry), m_budget(budget), m_start(micros())
+    {
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    /**
+     * @brief Stop measuring and record the time
+     *
+     */
+    ~ProfileScope()
+    {
+        if (m_entry == nullptr)
+        {
+            return;
+        }
+
+        unsigned long duration = micros() - m_start;
+        m_entry->record(duration);
+
+        if (m_budget > 0 && duration > m_budget)
+        {
+            m_entry->misses++;
+        }
+    }
+
+private:
+    ProfileEntry* m_entry;  ///< Where the measurement is recorded
+    unsigned long m_budget; ///< Maximum expected time
+    unsigned long m_start;  ///< Time of the construction
+};
+
+} // namespace aex
+
+#else // AEX_PROFILING
+
+#define AEX_PROFILE_SCOPE(name)
+#define AEX_PROFILE_SCOPE_BUDGET(name, budget)
+#define AEX_PROFILE_DUMP(printer)
+#define AEX_PROFILE_RESET()
+
+#endif // AEX_PROFILING
+
+#endif // _INCLUDE_AEX_PROFILER_H_
@@ -0,0 +1,262 @@
+/**
+ * @file RingBuffer.h
+ * @author Eliot Fondere
+ * @brief Fixed-Size Circular Queue safe to share between an interrupt and the main loop
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Example Usage:
+ * @code
+ * aex::RingBuffer<uint16_t, 64> ticks;
+ *
+ * void encoderISR()
+ * {
+ *     ticks.push(TCNT1); // never blocks, returns false if the buffer is full
+ * }
+ *
+ * void loop()
+ * {
+ *     uint16_t tick;
+ *
+ *     while (ticks.pop(tick)) // no need for noInterrupts()
+ *     {
+ *         Serial.println(tick);
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_RING_BUFFER_H_
+#define _INCLUDE_AEX_RING_BUFFER_H_
+
+#include "utils.h"
+#include "Array.h"
+#include <stdint.h>
+
+namespace aex
+{
+
+namespace priv
+{
+
+/**
+ * @brief Prevent the compiler (and the processor, where needed) from reordering memory accesses
+ * across this point
+ *
+ * AVR processors never reorder memory accesses so only the compiler needs to be stopped.
+ */
+inline void memoryBarrier()
+{
+#if defined(__AVR__)
+    __asm__ __volatile__("" ::: "memory");
+#else
+    __sync_synchronize();
+#endif
+}
+
+} // namespace priv
+
+/**
+ * @brief Lock-free single-producer/single-consumer circular queue
+ *
+ * @tparam T type of data contained in the queue
+ * @tparam N capacity of the queue (must be a power of two)
+ *
+ * One side (e.g. an interrupt) may only call the producer functions (push(), pushN()) while the
+ * other side (e.g. loop()) may only call the consumer functions (pop(), popN(), front(), clear()).
+ * Neither side has to disable interrupts: each index is only written by one side and is small
+ * enough to be read and written atomically (8 bits for N <= 128).
+ */
+template<typename T, size_t N>
+class RingBuffer
+{
+public:
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+#if defined(__AVR__)
+    static_assert(N <= 128, "RingBuffer capacity is limited to 128 on AVR so the indices stay 8 bits (atomic)");
+#endif
+
+    /**
+     * @brief Add an element to the queue (producer side)
+     *
+     * @param value new element (to be copied)
+     * @return true the element was added
+     * @return false the queue is full, the element was dropped
+     */
+    bool push(const T& value)
+    {
+        index_t head = m_head;
+
+        if (static_cast<index_t>(head - m_tail) >= N)
+        {
+            return false;
+        }
+
+        m_buffer[head & MASK] = value;
+
+        // publish the element before moving the head
+        priv::memoryBarrier();
+        m_head = static_cast<index_t>(head + 1);
+        return true;
+    }
+
+    /**
+     * @brief Add several elements to the queue (producer side)
+     *
+     * @param values pointer to the first element to copy
+     * @param count number of elements to copy
+     * @return size_t number of elements actually added (less than count if the queue fills up)
+     */
+    size_t pushN(const T* values, size_t count)
+    {
+        index_t head = m_head;
+        size_t space = N - static_cast<index_t>(head - m_tail);
+
+        if (count > space)
+        {
+            count = space;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            m_buffer[(head + i) & MASK] = values[i];
+        }
+
+        // publish all the elements at once
+        priv::memoryBarrier();
+        m_head = static_cast<index_t>(head + count);
+        return count;
+    }
+
+    /**
+     * @brief Remove the oldest element from the queue (consumer side)
+     *
+     * @param value where the element is copied
+     * @return true an element was removed
+     * @return false the queue is empty, value is left unchanged
+     */
+    bool pop(T& value)
+    {
+        index_t tail = m_tail;
+
+        if (tail == m_head)
+        {
+            return false;
+        }
+
+        // read the element only after seeing the head
+        priv::memoryBarrier();
+        value = m_buffer[tail & MASK];
+
+        // finish reading the element before giving its slot back
+        priv::memoryBarrier();
+        m_tail = static_cast<index_t>(tail + 1);
+        return true;
+    }
+
+    /**
+     * @brief Remove several elements from the queue (consumer side)
+     *
+     * @param values where the elements are copied
+     * @param count maximum number of elements to remove
+     * @return size_t number of elements actually removed
+     */
+    size_t popN(T* values, size_t count)
+    {
+        index_t tail = m_tail;
+        size_t available = static_cast<index_t>(m_head - tail);
+
+        if (count > available)
+        {
+            count = available;
+        }
+
+        priv::memoryBarrier();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = m_buffer[(tail + i) & MASK];
+        }
+
+        priv::memoryBarrier();
+        m_tail = static_cast<index_t>(tail + count);
+        return count;
+    }
+
+    /**
+     * @brief Get the oldest element without removing it (consumer side)
+     *
+     * @return T& reference to the oldest element (the queue must not be empty)
+     */
+    T& front()
+    {
+        priv::memoryBarrier();
+        return m_buffer[m_tail & MASK];
+    }
+
+    /**
+     * @brief Remove all elements (consumer side)
+     *
+     */
+    void clear()
+    {
+        m_tail = m_head;
+    }
+
+    /**
+     * @brief Get the amount of elements in the queue
+     *
+     * @return size_t number of elements (may already be outdated if the other side is running)
+     */
+    size_t getSize() const
+    {
+        return static_cast<index_t>(m_head - m_tail);
+    }
+
+    /**
+     * @brief Get the capacity of the queue
+     *
+     * @return size_t maximum amount of elements the queue can hold
+     */
+    constexpr size_t getCapacity() const
+    {
+        return N;
+    }
+
+    /**
+     * @brief Check if the queue is empty
+     *
+     * @return true queue is empty
+     * @return false queue is not empty
+     */
+    bool isEmpty() const
+    {
+        return (m_head == m_tail);
+    }
+
+    /**
+     * @brief Check if the queue is full
+     *
+     * @return true queue is full (push() would fail)
+     * @return false queue is not full
+     */
+    bool isFull() const
+    {
+        return (getSize() >= N);
+    }
+
+private:
+    /// Type of the indices, 8 bits when possible so they can be read and written atomically
+    using index_t = typename conditional<(N <= 128), uint8_t, size_t>::type;
+
+    static constexpr index_t MASK = static_cast<index_t>(N - 1); ///< mask to wrap the indices
+
+    Array<T, N> m_buffer;      ///< actual data contained in the queue
+
+    volatile index_t m_head = 0; ///< index of the next element to write (only written by the producer)
+    volatile index_t m_tail = 0; ///< index of the next element to read (only written by the consumer)
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_RING_BUFFER_H_
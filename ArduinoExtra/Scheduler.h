@@ -0,0 +1,517 @@
+/**
+ * @file Scheduler.h
+ * @author Eliot Fondere
+ * @brief Cooperative scheduler running periodic tasks at a fixed rate from loop()
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Example Usage:
+ * @code
+ * class Motor
+ * {
+ * public:
+ *     void update()
+ *     {
+ *         // PID, etc.
+ *     }
+ * };
+ *
+ * Motor motor;
+ * aex::Scheduler<20> scheduler;
+ * aex::Scheduler<20>::TaskId pidTask;
+ *
+ * void setup()
+ * {
+ *     pidTask = scheduler.addTask(aex::Function<void()>::bind<Motor, &Motor::update>(motor), 10); // every 10 ms
+ *     scheduler.addTask([]() -> void { Serial.println("alive"); }, 1000, 500); // every second, first run in 500 ms
+ * }
+ *
+ * void loop()
+ * {
+ *     scheduler.run(); // only looks at the next task when nothing is due
+ *
+ *     if (scheduler.getOverruns(pidTask) > 0)
+ *     {
+ *         Serial.println("PID loop is late");
+ *     }
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_SCHEDULER_H_
+#define _INCLUDE_AEX_SCHEDULER_H_
+
+#include "utils.h"
+#include "Functional.h"
+#include "StaticVector.h"
+#include "Profiler.h"
+
+namespace aex
+{
+
+/**
+ * @brief Fixed-capacity cooperative scheduler for periodic tasks
+ *
+ * @tparam N maximum amount of tasks
+ * @tparam Callback type of the task functions (Function<void()>, or FunctionRef<void()> to store
+ * only references)
+ *
+ * Tasks are kept in a binary heap ordered by deadline (inside a StaticVector, so nothing is ever
+ * allocated by the scheduler). run() only looks at the earliest task when nothing is due, and
+ * running a task and scheduling its next run is O(log n).
+ *
+ * Tasks run at a fixed rate: the next deadline is the previous deadline plus the period, not the
+ * time at which the task actually ran, so small delays do not accumulate. When a task is so late
+ * that whole periods were missed, the missed runs are skipped and counted as overruns.
+ *
+ * Time is in milliseconds when using run(), but run(now) accepts any unit (e.g. micros()) as long
+ * as the periods use the same one. Wrap around of the clock is handled.
+ *
+ * Note: tasks may add or remove tasks (including themselves) while they run, but clear() must not
+ * be called from a task.
+ */
+template<size_t N, typename Callback = Function<void()>>
+class Scheduler
+{
+public:
+    typedef unsigned int TaskId; ///< Identifies a task (0 is never a valid id)
+
+    /**
+     * @brief Add a periodic task
+     *
+     * @param callback function to call at every period
+     * @param period time between two runs of the task (0 to run it as often as possible)
+     * @param delay time before the first run
+     * @return TaskId id of the new task, 0 if the scheduler is full (the task was not added)
+     */
+    TaskId addTask(Callback callback, unsigned long period, unsigned long delay = 0)
+    {
+        return addTask(move(callback), period, delay, millis());
+    }
+
+    /**
+     * @brief Add a periodic task
+     *
+     * @param callback function to call at every period
+     * @param period time between two runs of the task (0 to run it as often as possible)
+     * @param delay time before the first run
+     * @param now current time (same unit as the period)
+     * @return TaskId id of the new task, 0 if the scheduler is full (the task was not added)
+     */
+    TaskId addTask(Callback callback, unsigned long period, unsigned long delay, unsigned long now)
+    {
+        if (m_tasks.isFull())
+        {
+            // error: the scheduler is full
+            return 0;
+        }
+
+        if (++m_lastId == 0)
+        {
+            // skip the invalid id when wrapping around
+            ++m_lastId;
+        }
+
+        m_tasks.emplaceBack(move(callback), period, now + delay, m_lastId);
+        siftUp(m_tasks.getSize() - 1);
+        return m_lastId;
+    }
+
+    /**
+     * @brief Remove a task
+     *
+     * @param id id returned by addTask()
+     * @return true the task was removed
+     * @return false there is no task with this id
+     */
+    bool removeTask(TaskId id)
+    {
+        size_t index = find(id);
+
+        if (index >= m_tasks.getSize())
+        {
+            return false;
+        }
+
+        if (m_running && index == 0)
+        {
+            // the task is running (always at the top of the heap), removed once it returns
+            m_tasks[0].id = 0;
+            return true;
+        }
+
+        removeAt(index);
+        return true;
+    }
+
+    /**
+     * @brief Run the tasks that are due (call it in loop())
+     *
+     * @return size_t number of tasks that ran
+     */
+    size_t run()
+    {
+        return run(millis());
+    }
+
+    /**
+     * @brief Run the tasks that are due at a given time
+     *
+     * @param now current time (same unit as the periods)
+     * @return size_t number of tasks that ran
+     *
+     * Each task runs at most once per call, even if it is late.
+     */
+    size_t run(unsigned long now)
+    {
+        size_t count = 0;
+
+        while (!m_tasks.isEmpty() && !isBefore(now, m_tasks[0].deadline))
+        {
+            // the task stays at the top of the heap while it runs (see siftUp())
+            m_running = true;
+#ifdef AEX_PROFILING
+            {
+                ProfileScope scope(m_tasks[0].profile);
+                m_tasks[0].callback();
+            }
+#else
+            m_tasks[0].callback();
+#endif
+            m_running = false;
+            count++;
+
+            if (m_tasks[0].id == 0)
+            {
+                // the task removed itself
+                removeAt(0);
+                continue;
+            }
+
+            reschedule(m_tasks[0], now);
+            siftDown(0);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Get the number of runs a task skipped because it was late by a whole period or more
+     *
+     * @param id id returned by addTask()
+     * @return unsigned int number of skipped runs (0 if there is no task with this id)
+     */
+    unsigned int getOverruns(TaskId id) const
+    {
+        size_t index = find(id);
+        return (index < m_tasks.getSize()) ? m_tasks[index].overruns : 0;
+    }
+
+    /**
+     * @brief Record the run times and skipped runs of a task in the profiler (see Profiler.h)
+     *
+     * @param id id returned by addTask()
+     * @param name name of the task in the profiler (a string literal for example)
+     *
+     * @note Does nothing unless AEX_PROFILING is defined.
+     */
+    void profileTask(TaskId id, const char* name)
+    {
+#ifdef AEX_PROFILING
+        size_t index = find(id);
+
+        if (index < m_tasks.getSize())
+        {
+            m_tasks[index].profile = Profiler::getEntry(name);
+        }
+#else
+        (void)id;
+        (void)name;
+#endif
+    }
+
+    /**
+     * @brief Get the number of runs skipped by all the tasks
+     *
+     * @return unsigned long total number of skipped runs (kept when tasks are removed)
+     */
+    unsigned long getTotalOverruns() const
+    {
+        return m_totalOverruns;
+    }
+
+    /**
+     * @brief Get the deadline of the next task to run
+     *
+     * @return unsigned long time at which the earliest task is due (the scheduler must not be empty)
+     *
+     * Useful to sleep until there is something to do.
+     */
+    unsigned long getNextDeadline() const
+    {
+        return m_tasks[0].deadline;
+    }
+
+    /**
+     * @brief Remove all the tasks (must not be called from a task)
+     *
+     */
+    void clear()
+    {
+        m_tasks.clear();
+    }
+
+    /**
+     * @brief Get the amount of tasks
+     *
+     * @return size_t number of tasks in the scheduler
+     */
+    size_t getSize() const
+    {
+        return m_tasks.getSize();
+    }
+
+    /**
+     * @brief Get the maximum amount of tasks
+     *
+     * @return size_t capacity of the scheduler
+     */
+    constexpr size_t getCapacity() const
+    {
+        return N;
+    }
+
+    /**
+     * @brief Check if there is no task
+     *
+     * @return true scheduler is empty
+     * @return false scheduler has at least one task
+     */
+    bool isEmpty() const
+    {
+        return m_tasks.isEmpty();
+    }
+
+    /**
+     * @brief Check if no more tasks can be added
+     *
+     * @return true scheduler is full (addTask() would fail)
+     * @return false scheduler is not full
+     */
+    bool isFull() const
+    {
+        return m_tasks.isFull();
+    }
+
+private:
+    /**
+     * @brief A periodic task and its timing
+     */
+    struct Task
+    {
+        /**
+         * @brief Create a new task
+         *
+         * @param newCallback function of the task (moved into the task)
+         * @param newPeriod time between two runs
+         * @param firstDeadline time of the first run
+         * @param newId id of the task
+         */
+        Task(Callback&& newCallback, unsigned long newPeriod, unsigned long firstDeadline, TaskId newId)
+        : callback(move(newCallback)), period(newPeriod), deadline(firstDeadline), id(newId)
+        {
+        }
+
+        Callback      callback;     ///< Function called at every period
+        unsigned long period;       ///< Time between two runs
+        unsigned long deadline;     ///< Time of the next run
+        unsigned int  overruns = 0; ///< Number of skipped runs
+        TaskId        id;           ///< Id of the task (0 once removed while running)
+#ifdef AEX_PROFILING
+        ProfileEntry* profile = nullptr; ///< Where the run times are recorded
+#endif
+    };
+
+    /**
+     * @brief Compare two times, handling the clock wrapping around
+     *
+     * @param a first time
+     * @param b second time
+     * @return true a is before b
+     * @return false a is at the same time or after b
+     */
+    static bool isBefore(unsigned long a, unsigned long b)
+    {
+        return static_cast<long>(a - b) < 0;
+    }
+
+    /**
+     * @brief Compute the next deadline of a task that just ran (fixed rate)
+     *
+     * @param task task that ran
+     * @param now time at which the task was started
+     */
+    void reschedule(Task& task, unsigned long now)
+    {
+        if (task.period == 0)
+        {
+            // due again at the next time unit, so it does not run twice in the same call
+            task.deadline = now + 1;
+            return;
+        }
+
+        // number of whole periods the task was late by, these runs are skipped
+        unsigned long missed = (now - task.deadline) / task.period;
+
+        task.overruns += missed;
+        m_totalOverruns += missed;
+
+#ifdef AEX_PROFILING
+        if (task.profile != nullptr)
+        {
+            task.profile->misses += missed;
+        }
+#endif
+        task.deadline += (missed + 1) * task.period;
+    }
+
+    /**
+     * @brief Find the index of a task in the heap
+     *
+     * @param id id of the task
+     * @return size_t index of the task, the size of the heap if there is none
+     */
+    size_t find(TaskId id) const
+    {
+        if (id == 0)
+        {
+            return m_tasks.getSize();
+        }
+
+        size_t index = 0;
+
+        while (index < m_tasks.getSize() && m_tasks[index].id != id)
+        {
+            index++;
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Remove a task from the heap
+     *
+     * @param index index of the task to remove
+     */
+    void removeAt(size_t index)
+    {
+        size_t last = m_tasks.getSize() - 1;
+
+        if (index != last)
+        {
+            m_tasks[index] = move(m_tasks[last]);
+        }
+
+        m_tasks.popBack();
+
+        if (index < m_tasks.getSize())
+        {
+            siftUp(index);
+            siftDown(index);
+        }
+    }
+
+    /**
+     * @brief Move a task up the heap until its parent is not due after it
+     *
+     * @param index index of the task
+     */
+    void siftUp(size_t index)
+    {
+        // never replace a running task, it is put back in place by siftDown() once it returns
+        size_t top = m_running ? 1 : 0;
+
+        if (index <= top || !isBefore(m_tasks[index].deadline, m_tasks[(index - 1) / 2].deadline))
+        {
+            return;
+        }
+
+        // move the parents down into the hole instead of swapping at every level
+        Task task(move(m_tasks[index]));
+
+        while (index > top)
+        {
+            size_t parent = (index - 1) / 2;
+
+            if (!isBefore(task.deadline, m_tasks[parent].deadline))
+            {
+                break;
+            }
+
+            m_tasks[index] = move(m_tasks[parent]);
+            index = parent;
+        }
+
+        m_tasks[index] = move(task);
+    }
+
+    /**
+     * @brief Move a task down the heap until its children are not due before it
+     *
+     * @param index index of the task
+     */
+    void siftDown(size_t index)
+    {
+        size_t child = earliestChild(index);
+
+        if (child == 0 || !isBefore(m_tasks[child].deadline, m_tasks[index].deadline))
+        {
+            return;
+        }
+
+        // move the children up into the hole instead of swapping at every level
+        Task task(move(m_tasks[index]));
+
+        while (child != 0 && isBefore(m_tasks[child].deadline, task.deadline))
+        {
+            m_tasks[index] = move(m_tasks[child]);
+            index = child;
+            child = earliestChild(index);
+        }
+
+        m_tasks[index] = move(task);
+    }
+
+    /**
+     * @brief Get the child of a task that is due first
+     *
+     * @param index index of the parent task
+     * @return size_t index of the child, 0 if the task has no children
+     */
+    size_t earliestChild(size_t index) const
+    {
+        size_t child = 2 * index + 1;
+
+        if (child >= m_tasks.getSize())
+        {
+            return 0;
+        }
+
+        if (child + 1 < m_tasks.getSize() && isBefore(m_tasks[child + 1].deadline, m_tasks[child].deadline))
+        {
+            child++;
+        }
+
+        return child;
+    }
+
+    StaticVector<Task, N> m_tasks;             ///< Tasks, in a binary heap by deadline
+
+    TaskId        m_lastId = 0;               ///< Last id given by addTask()
+    unsigned long m_totalOverruns = 0;        ///< Runs skipped by all the tasks
+    bool          m_running = false;          ///< A task is running
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_SCHEDULER_H_
@@ -0,0 +1,192 @@
+/**
+ * @file SmallVector.h
+ * @author Eliot Fondere
+ * @brief Dynamic Array Container storing its first elements inline
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ */
+
+#ifndef _INCLUDE_AEX_SMALL_VECTOR_H_
+#define _INCLUDE_AEX_SMALL_VECTOR_H_
+
+#include "utils.h"
+#include "Vector.h"
+#include "VectorBase.h"
+#include "Allocator.h"
+#include <new>
+
+namespace aex
+{
+
+/**
+ * @brief Vector class storing up to N elements inside the object, and on the heap beyond that
+ *
+ * @tparam T type of data contained in the vector
+ * @tparam N amount of elements stored inline (without allocating memory)
+ * @tparam GrowthPolicy how the capacity increases once the vector is on the heap
+ * @tparam Allocator where the elements are allocated beyond the inline storage (see Allocator.h)
+ * @tparam SizeType unsigned integer type storing the size and capacity (see CompactVector)
+ *
+ * Has the same interface as Vector. As long as the vector holds N elements or less, no memory is
+ * allocated. shrinkToFit() moves the elements back inline when they fit.
+ */
+template<typename T, size_t N, typename GrowthPolicy = GrowthDouble, typename Allocator = HeapAllocator, typename SizeType = size_t>
+class SmallVector : private priv::InlineStorage<T, N>,
+                    public priv::VectorBase<T, GrowthPolicy, SmallVector<T, N, GrowthPolicy, Allocator, SizeType>, SizeType>
+{
+    typedef priv::InlineStorage<T, N> Storage; // first base, so it exists when Base is initialized
+    typedef priv::VectorBase<T, GrowthPolicy, SmallVector, SizeType> Base;
+
+public:
+    static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+    static_assert(N <= static_cast<SizeType>(-1), "the inline capacity of a SmallVector must fit in its size type");
+
+    /**
+     * @brief Initialize an empty vector (using the inline storage)
+     *
+     */
+    SmallVector()
+    : Base(Storage::inlineData(), N)
+    {
+    }
+
+    /**
+     * @brief Initialize an empty vector with a given capacity
+     *
+     * @param initialCapacity intial capacity of the vector (only allocates if larger than N)
+     */
+    SmallVector(size_t initialCapacity)
+    : Base(Storage::inlineData(), N)
+    {
+        this->reserve(initialCapacity);
+    }
+
+    /**
+     * @brief Initialize a vector by copying another
+     *
+     * @param other vector to copy
+     */
+    SmallVector(const SmallVector& other)
+    : Base(Storage::inlineData(), N)
+    {
+        this->copyFrom(other);
+    }
+
+    /**
+     * @brief Initialize a vector by moving the elements of another
+     *
+     * @param other vector to move (left empty)
+     *
+     * Elements on the heap are transferred without allocating, inline elements are moved one by one.
+     */
+    SmallVector(SmallVector&& other)
+    : Base(Storage::inlineData(), N)
+    {
+        this->moveFrom(other);
+    }
+
+    /**
+     * @brief Copy the elements of another vector
+     *
+     * @param other vector to copy
+     * @return SmallVector& reference to this vector
+     */
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            this->copyFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move the elements of another vector
+     *
+     * @param other vector to move (left empty)
+     * @return SmallVector& reference to this vector
+     */
+    SmallVector& operator=(SmallVector&& other)
+    {
+        if (this != &other)
+        {
+            this->moveFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Empty the vector and free memory
+     *
+     */
+    ~SmallVector()
+    {
+        this->release();
+    }
+
+    /**
+     * @brief Check if the elements are currently stored inline
+     *
+     * @return true the elements are stored inside the object
+     * @return false the elements are stored on the heap
+     */
+    bool isInline() const
+    {
+        return !isOnHeap(this->m_data);
+    }
+
+private:
+    friend Base; // for the memory management functions
+
+    /**
+     * @brief Get a block of memory, the inline storage if the capacity fits or the allocator otherwise
+     *
+     * @param capacity amount of elements the block must hold (increased to N for the inline storage)
+     * @return T* pointer to the block
+     */
+    T* allocate(size_t& capacity)
+    {
+        if (capacity <= N)
+        {
+            capacity = N;
+            return Storage::inlineData();
+        }
+
+        return static_cast<T*>(Allocator::allocate(capacity * sizeof(T)));
+    }
+
+    /**
+     * @brief Free a block of memory returned by allocate()
+     *
+     * @param block pointer to the block (nothing is done for the inline storage)
+     * @param capacity amount of elements the block can hold
+     */
+    void deallocate(T* block, size_t capacity)
+    {
+        if (!isOnHeap(block))
+        {
+            return;
+        }
+
+        Allocator::deallocate(block, capacity * sizeof(T));
+    }
+
+    /**
+     * @brief Check if a block of memory is on the heap (and can be transferred to another vector)
+     *
+     * @param block pointer to the block
+     * @return true the block is on the heap
+     * @return false the block is the inline storage (or there is none)
+     */
+    bool isOnHeap(const T* block) const
+    {
+        return (block != nullptr && block != Storage::inlineData());
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_SMALL_VECTOR_H_
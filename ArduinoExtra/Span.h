@@ -0,0 +1,451 @@
+/**
+ * @file Span.h
+ * @author Eliot Fondere
+ * @brief Non-owning view over contiguous elements (Array, vectors, C arrays or raw buffers)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * A Span is only a pointer and a size, so functions taking a Span work with any contiguous
+ * container without copying it or being templated on its size. The elements must outlive the
+ * Span, and adding elements to a vector can move them (making its spans invalid).
+ *
+ * Example Usage:
+ * @code
+ * long average(aex::Span<const int16_t> samples)
+ * {
+ *     long total = 0;
+ *
+ *     for (int16_t sample : samples)
+ *     {
+ *         total += sample;
+ *     }
+ *
+ *     return samples.isEmpty() ? 0 : total / static_cast<long>(samples.getSize());
+ * }
+ *
+ * aex::Array<int16_t, 64> window;
+ * aex::Vector<int16_t> history;
+ * uint8_t dmaBuffer[128];
+ *
+ * average(window);
+ * average(history);
+ * average(aex::Span<const int16_t>(window).subspan(16, 32)); // only the middle of the window
+ * average(aex::Span<const int16_t>(reinterpret_cast<const int16_t*>(dmaBuffer), 64));
+ *
+ * aex::Span<int16_t, 64> fixed(window); // size known at compile time, only stores the pointer
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_SPAN_H_
+#define _INCLUDE_AEX_SPAN_H_
+
+#include "utils.h"
+#include "Array.h"
+#include "BoundsCheck.h"
+
+namespace aex
+{
+
+/**
+ * @brief Extent of a Span whose size is only known at run time
+ */
+constexpr size_t dynamicExtent = static_cast<size_t>(-1);
+
+template<typename T, size_t Extent = dynamicExtent>
+class Span;
+
+template<typename T, size_t S>
+class FlashArray;
+
+namespace priv
+{
+
+/**
+ * @brief Size of a Span known at compile time (takes no memory)
+ *
+ * @tparam Extent size of the Span
+ */
+template<size_t Extent>
+class SpanExtent
+{
+public:
+    constexpr explicit SpanExtent(size_t)
+    {
+    }
+
+    constexpr size_t getSize() const
+    {
+        return Extent;
+    }
+};
+
+/**
+ * @brief Size of a Span only known at run time
+ *
+ * @see SpanExtent
+ */
+template<>
+class SpanExtent<dynamicExtent>
+{
+public:
+    constexpr explicit SpanExtent(size_t size)
+    : m_size(size)
+    {
+    }
+
+    constexpr size_t getSize() const
+    {
+        return m_size;
+    }
+
+private:
+    size_t m_size; ///< number of elements
+};
+
+/**
+ * @brief Check if an array of From can be viewed as an array of To (same type, or adding const)
+ *
+ * Pointers to arrays only convert when the element types are the same apart from qualifiers, so
+ * a Span of a derived class cannot be viewed as a Span of its base (the sizes would differ).
+ */
+template<typename From, typename To>
+struct IsSpanConvertible
+{
+    static char test(To (*)[]);
+    static long test(...);
+
+    static constexpr bool value = (sizeof(test(static_cast<From (*)[]>(nullptr))) == sizeof(char));
+};
+
+/**
+ * @brief Check if a container can be viewed by a Span (Span itself and FlashArray are excluded)
+ *
+ * @tparam C type of the container
+ */
+template<typename C>
+struct IsSpanContainer
+{
+    static constexpr bool value = true;
+};
+
+template<typename T, size_t E>
+struct IsSpanContainer<Span<T, E>>
+{
+    static constexpr bool value = false;
+};
+
+template<typename T, size_t E>
+struct IsSpanContainer<const Span<T, E>>
+{
+    static constexpr bool value = false;
+};
+
+template<typename T, size_t S>
+struct IsSpanContainer<FlashArray<T, S>>
+{
+    static constexpr bool value = false; // its elements are in flash and cannot be referenced
+};
+
+template<typename T, size_t S>
+struct IsSpanContainer<const FlashArray<T, S>>
+{
+    static constexpr bool value = false;
+};
+
+} // namespace priv
+
+/**
+ * @brief View over contiguous elements that does not own them
+ *
+ * @tparam T type of the elements (const T for a read-only view)
+ * @tparam Extent number of elements if known at compile time, dynamicExtent otherwise
+ *
+ * A Span<T> converts to a Span<const T>, and a Span<T, N> to a Span<T>. Slicing functions limit
+ * their arguments to the elements of the Span, like the bulk functions of the vectors.
+ */
+template<typename T, size_t Extent>
+class Span : private priv::SpanExtent<Extent>
+{
+    typedef priv::SpanExtent<Extent> ExtentType;
+
+public:
+    /**
+     * @brief Create an empty span (only if its extent is dynamic or zero)
+     *
+     * @tparam E extent (no need to manually type)
+     */
+    template<size_t E = Extent, typename = typename enable_if<E == 0 || E == dynamicExtent>::type>
+    constexpr Span()
+    : ExtentType(0), m_data(nullptr)
+    {
+    }
+
+    /**
+     * @brief Create a span over a raw buffer
+     *
+     * @param data pointer to the first element
+     * @param size number of elements (must be Extent if the extent is not dynamic)
+     */
+    constexpr Span(T* data, size_t size)
+    : ExtentType(size), m_data(data)
+    {
+    }
+
+    /**
+     * @brief Create a span over a C array
+     *
+     * @tparam U type of the elements of the array (no need to manually type)
+     * @tparam N size of the array (no need to manually type)
+     * @param array array to view
+     */
+    template<typename U, size_t N, typename = typename enable_if<(Extent == dynamicExtent || Extent == N) && priv::IsSpanConvertible<U, T>::value>::type>
+    constexpr Span(U (&array)[N])
+    : ExtentType(N), m_data(array)
+    {
+    }
+
+    /**
+     * @brief Create a span over an Array
+     *
+     * @tparam U type of the elements of the array (no need to manually type)
+     * @tparam N size of the array (no need to manually type)
+     * @param array array to view
+     */
+    template<typename U, size_t N, typename = typename enable_if<(Extent == dynamicExtent || Extent == N) && priv::IsSpanConvertible<U, T>::value>::type>
+    constexpr Span(Array<U, N>& array)
+    : ExtentType(N), m_data(array.m_data)
+    {
+    }
+
+    /**
+     * @brief Create a read-only span over a const Array
+     *
+     * @tparam U type of the elements of the array (no need to manually type)
+     * @tparam N size of the array (no need to manually type)
+     * @param array array to view
+     */
+    template<typename U, size_t N, typename = typename enable_if<(Extent == dynamicExtent || Extent == N) && priv::IsSpanConvertible<const U, T>::value>::type>
+    constexpr Span(const Array<U, N>& array)
+    : ExtentType(N), m_data(array.m_data)
+    {
+    }
+
+    /**
+     * @brief Create a span over the elements of a container (Vector, StaticVector, SmallVector...)
+     *
+     * @tparam C type of the container, anything with data() and getSize() (no need to manually type)
+     * @param container container to view (its elements must not move while the span is used)
+     *
+     * Only available for spans with a dynamic extent since the size of the container is only
+     * known at run time.
+     */
+    template<typename C, typename = typename enable_if<Extent == dynamicExtent && priv::IsSpanContainer<C>::value
+        && priv::IsSpanConvertible<typename remove_reference<decltype(*static_cast<C*>(nullptr)->data())>::type, T>::value>::type>
+    Span(C& container)
+    : ExtentType(container.getSize()), m_data(container.data())
+    {
+    }
+
+    /**
+     * @brief Create a span from another span (adding const or forgetting the extent)
+     *
+     * @tparam U type of the elements of the other span (no need to manually type)
+     * @tparam E extent of the other span (no need to manually type)
+     * @param other span to copy
+     */
+    template<typename U, size_t E, typename = typename enable_if<(Extent == dynamicExtent || Extent == E) && priv::IsSpanConvertible<U, T>::value>::type>
+    constexpr Span(const Span<U, E>& other)
+    : ExtentType(other.getSize()), m_data(other.data())
+    {
+    }
+
+    /**
+     * @brief Get the number of elements
+     *
+     * @return size_t size of the span
+     */
+    constexpr size_t getSize() const
+    {
+        return ExtentType::getSize();
+    }
+
+    /**
+     * @brief Get the size of the elements in bytes
+     *
+     * @return size_t number of bytes viewed by the span
+     */
+    constexpr size_t getSizeBytes() const
+    {
+        return getSize() * sizeof(T);
+    }
+
+    /**
+     * @brief Check if the span is empty
+     *
+     * @return true span has no elements
+     * @return false span has elements
+     */
+    constexpr bool isEmpty() const
+    {
+        return (getSize() == 0);
+    }
+
+    /**
+     * @brief Access an element
+     *
+     * @param index index of the element
+     * @return T& reference to the element
+     *
+     * Note: the index is checked according to AEX_BOUNDS_CHECK (see BoundsCheck.h)
+     */
+    constexpr T& operator[](size_t index) const
+    {
+        return m_data[priv::checkIndex(index, getSize())];
+    }
+
+    /**
+     * @brief Get the first element
+     *
+     * @return T& reference to the first element (the span must not be empty)
+     */
+    constexpr T& front() const
+    {
+        return m_data[0];
+    }
+
+    /**
+     * @brief Get the last element
+     *
+     * @return T& reference to the last element (the span must not be empty)
+     */
+    constexpr T& back() const
+    {
+        return m_data[getSize() - 1];
+    }
+
+    /**
+     * @brief Get a pointer to the elements
+     *
+     * @return T* pointer to the first element
+     */
+    constexpr T* data() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     *
+     * @return T* pointer to the first element
+     */
+    constexpr T* begin() const
+    {
+        return m_data;
+    }
+
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     *
+     * @return T* pointer past the last element
+     */
+    constexpr T* end() const
+    {
+        return m_data + getSize();
+    }
+
+    /**
+     * @brief View the first elements
+     *
+     * @param count number of elements (limited to the size of the span)
+     * @return Span<T> span over the first count elements
+     */
+    constexpr Span<T> first(size_t count) const
+    {
+        return Span<T>(m_data, (count < getSize()) ? count : getSize());
+    }
+
+    /**
+     * @brief View the last elements
+     *
+     * @param count number of elements (limited to the size of the span)
+     * @return Span<T> span over the last count elements
+     */
+    constexpr Span<T> last(size_t count) const
+    {
+        return (count < getSize()) ? Span<T>(m_data + (getSize() - count), count) : Span<T>(m_data, getSize());
+    }
+
+    /**
+     * @brief View the first elements, with a size known at compile time
+     *
+     * @tparam Count number of elements (must not be larger than the size of the span)
+     * @return Span<T, Count> span over the first Count elements
+     */
+    template<size_t Count>
+    constexpr Span<T, Count> first() const
+    {
+        static_assert(Extent == dynamicExtent || Count <= Extent, "the span is smaller than the requested count");
+        return Span<T, Count>(m_data, Count);
+    }
+
+    /**
+     * @brief View the last elements, with a size known at compile time
+     *
+     * @tparam Count number of elements (must not be larger than the size of the span)
+     * @return Span<T, Count> span over the last Count elements
+     */
+    template<size_t Count>
+    constexpr Span<T, Count> last() const
+    {
+        static_assert(Extent == dynamicExtent || Count <= Extent, "the span is smaller than the requested count");
+        return Span<T, Count>(m_data + (getSize() - Count), Count);
+    }
+
+    /**
+     * @brief View a range of elements
+     *
+     * @param offset index of the first element (limited to the size of the span)
+     * @param count number of elements (limited to the end of the span, dynamicExtent for all the
+     * remaining elements)
+     * @return Span<T> span over the range
+     */
+    constexpr Span<T> subspan(size_t offset, size_t count = dynamicExtent) const
+    {
+        return (offset < getSize()) ? Span<T>(m_data + offset, (count < getSize() - offset) ? count : getSize() - offset)
+                                    : Span<T>(m_data + getSize(), 0);
+    }
+
+private:
+    T* m_data; ///< pointer to the first element
+};
+
+/**
+ * @brief Create a span over a container without typing the element type
+ *
+ * @tparam C type of the container, anything with data() and getSize() (no need to manually type)
+ * @param container container to view
+ * @return Span over the elements of the container (read-only if the container is const)
+ */
+template<typename C, typename = typename enable_if<priv::IsSpanContainer<C>::value>::type>
+auto makeSpan(C& container) -> Span<typename remove_reference<decltype(*container.data())>::type>
+{
+    return Span<typename remove_reference<decltype(*container.data())>::type>(container.data(), container.getSize());
+}
+
+/**
+ * @brief Create a span over a C array without typing the element type
+ *
+ * @tparam T type of the elements (no need to manually type)
+ * @tparam N size of the array (no need to manually type)
+ * @param array array to view
+ * @return Span<T, N> span over the array
+ */
+template<typename T, size_t N>
+constexpr Span<T, N> makeSpan(T (&array)[N])
+{
+    return Span<T, N>(array, N);
+}
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_SPAN_H_
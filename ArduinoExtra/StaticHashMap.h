@@ -0,0 +1,198 @@
+/**
+ * @file StaticHashMap.h
+ * @author Eliot Fondere
+ * @brief Hash Map Container with a Fixed Capacity (no heap allocation)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Example Usage:
+ * @code
+ * aex::StaticHashMap<uint8_t, unsigned long, 16> lastSeen; // CAN id -> time of the last message
+ *
+ * void onMessage(uint8_t id)
+ * {
+ *     if (lastSeen.insert(id, millis()) == nullptr)
+ *     {
+ *         Serial.println("too many devices");
+ *     }
+ * }
+ *
+ * aex::StaticHashMap<const char*, float, 8> parameters;
+ * parameters.insert("kP", 1.2f);
+ *
+ * if (float* kP = parameters.find("kP"))
+ * {
+ *     *kP *= 2.0f;
+ * }
+ * @endcode
+ */
+
+#ifndef _INCLUDE_AEX_STATIC_HASH_MAP_H_
+#define _INCLUDE_AEX_STATIC_HASH_MAP_H_
+
+#include "utils.h"
+#include "Memory.h"
+#include "HashMapBase.h"
+
+namespace aex
+{
+
+namespace priv
+{
+
+/**
+ * @brief Storage of a StaticHashMap, inherited before its HashMapBase so it exists when the base
+ * is initialized
+ *
+ * @tparam Entry type of the entries
+ * @tparam N amount of slots
+ */
+template<typename Entry, size_t N>
+struct StaticHashMapStorage : InlineStorage<Entry, N>
+{
+    bool m_flags[N] = {}; ///< which slots hold an entry
+};
+
+} // namespace priv
+
+/**
+ * @brief Hash map storing its entries inside the object (open addressing, never allocates)
+ *
+ * @tparam K type of the keys
+ * @tparam V type of the values
+ * @tparam N maximum amount of entries (must be a power of two)
+ * @tparam H how keys are hashed and compared (see Hash)
+ *
+ * Has the same interface as HashMap. Lookups get slower as the map fills up, so choose N about
+ * a third larger than the amount of entries expected. Inserting a new key in a full map fails.
+ */
+template<typename K, typename V, size_t N, typename H = Hash<K>>
+class StaticHashMap : private priv::StaticHashMapStorage<priv::HashMapEntry<K, V>, N>,
+                      public priv::HashMapBase<K, V, H, StaticHashMap<K, V, N, H>>
+{
+    typedef priv::StaticHashMapStorage<priv::HashMapEntry<K, V>, N> Storage;
+    typedef priv::HashMapBase<K, V, H, StaticHashMap> Base;
+
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "StaticHashMap needs a capacity that is a power of two");
+
+    /**
+     * @brief Initialize an empty map
+     *
+     */
+    StaticHashMap()
+    : Base(Storage::inlineData(), Storage::m_flags, N)
+    {
+    }
+
+    /**
+     * @brief Initialize a map by copying another
+     *
+     * @param other map to copy
+     */
+    StaticHashMap(const StaticHashMap& other)
+    : Base(Storage::inlineData(), Storage::m_flags, N)
+    {
+        this->copyFrom(other);
+    }
+
+    /**
+     * @brief Initialize a map by moving the entries of another
+     *
+     * @param other map to move (left empty)
+     */
+    StaticHashMap(StaticHashMap&& other)
+    : Base(Storage::inlineData(), Storage::m_flags, N)
+    {
+        this->moveEntriesFrom(other);
+    }
+
+    /**
+     * @brief Copy the entries of another map
+     *
+     * @param other map to copy
+     * @return StaticHashMap& reference to this map
+     */
+    StaticHashMap& operator=(const StaticHashMap& other)
+    {
+        if (this != &other)
+        {
+            this->copyFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move the entries of another map
+     *
+     * @param other map to move (left empty)
+     * @return StaticHashMap& reference to this map
+     */
+    StaticHashMap& operator=(StaticHashMap&& other)
+    {
+        if (this != &other)
+        {
+            this->moveEntriesFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Empty the map
+     *
+     */
+    ~StaticHashMap()
+    {
+        this->clear();
+    }
+
+    /**
+     * @brief Check if the map is full
+     *
+     * @return true no other key can be added
+     * @return false there are free slots left
+     */
+    bool isFull() const
+    {
+        return (this->m_size == N);
+    }
+
+private:
+    friend Base; // for the memory management functions
+
+    typedef typename Base::Entry Entry;
+
+    /**
+     * @brief The storage cannot be replaced
+     *
+     * @return false always
+     */
+    bool allocate(size_t, Entry*&, bool*&)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Nothing to free, the storage is part of the map
+     *
+     */
+    void deallocate(Entry*, bool*, size_t)
+    {
+    }
+
+    /**
+     * @brief The capacity never changes
+     *
+     * @return size_t N
+     */
+    size_t getGrowth(size_t) const
+    {
+        return N;
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_STATIC_HASH_MAP_H_
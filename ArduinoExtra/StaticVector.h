@@ -0,0 +1,183 @@
+/**
+ * @file StaticVector.h
+ * @author Eliot Fondere
+ * @brief Dynamic Array Container with a Fixed Capacity (no heap allocation)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ */
+
+#ifndef _INCLUDE_AEX_STATIC_VECTOR_H_
+#define _INCLUDE_AEX_STATIC_VECTOR_H_
+
+#include "utils.h"
+#include "Memory.h"
+#include "Vector.h"
+#include "VectorBase.h"
+
+namespace aex
+{
+
+/**
+ * @brief Vector class storing its elements inside the object instead of on the heap
+ *
+ * @tparam T type of data contained in the vector
+ * @tparam N maximum amount of elements (capacity) of the vector
+ *
+ * Has the same interface as Vector, so one can replace the other without changing the code using
+ * it, but never allocates memory. Since the capacity cannot change, adding an element to a full
+ * vector fails (like a Vector with the GrowthNever policy): pushBack() returns false and
+ * emplaceBack() returns nullptr. reserve() and shrinkToFit() do nothing.
+ */
+template<typename T, size_t N>
+class StaticVector : private priv::InlineStorage<T, N>,
+                     public priv::VectorBase<T, GrowthNever, StaticVector<T, N>>
+{
+    typedef priv::InlineStorage<T, N> Storage; // first base, so it exists when Base is initialized
+    typedef priv::VectorBase<T, GrowthNever, StaticVector> Base;
+
+public:
+    static_assert(N > 0, "StaticVector needs a capacity of at least one element");
+
+    /**
+     * @brief Initialize an empty vector
+     *
+     */
+    StaticVector()
+    : Base(Storage::inlineData(), N)
+    {
+    }
+
+    /**
+     * @brief Initialize a vector by copying another
+     *
+     * @param other vector to copy
+     */
+    StaticVector(const StaticVector& other)
+    : Base(Storage::inlineData(), N)
+    {
+        this->copyFrom(other);
+    }
+
+    /**
+     * @brief Initialize a vector by moving the elements of another
+     *
+     * @param other vector to move (left empty)
+     */
+    StaticVector(StaticVector&& other)
+    : Base(Storage::inlineData(), N)
+    {
+        this->moveFrom(other);
+    }
+
+    /**
+     * @brief Copy the elements of another vector
+     *
+     * @param other vector to copy
+     * @return StaticVector& reference to this vector
+     */
+    StaticVector& operator=(const StaticVector& other)
+    {
+        if (this != &other)
+        {
+            this->copyFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move the elements of another vector
+     *
+     * @param other vector to move (left empty)
+     * @return StaticVector& reference to this vector
+     */
+    StaticVector& operator=(StaticVector&& other)
+    {
+        if (this != &other)
+        {
+            this->moveFrom(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Empty the vector
+     *
+     */
+    ~StaticVector()
+    {
+        this->release();
+    }
+
+    /**
+     * @brief Get the capacity of the vector
+     *
+     * @return size_t maximum amount of elements the vector can store
+     */
+    constexpr size_t getCapacity() const
+    {
+        return N;
+    }
+
+    /**
+     * @brief Check if the vector is full
+     *
+     * @return true vector is full (adding an element fails)
+     * @return false vector is not full
+     */
+    bool isFull() const
+    {
+        return (this->getSize() >= N);
+    }
+
+private:
+    friend Base; // for the memory management functions
+
+    /**
+     * @brief Get a block of memory, always the inline storage
+     *
+     * @param capacity amount of elements the block must hold (set to N)
+     * @return T* pointer to the inline storage, nullptr if the capacity is larger than N
+     */
+    T* allocate(size_t& capacity)
+    {
+        if (capacity > N)
+        {
+            // error: a StaticVector cannot grow
+            return nullptr;
+        }
+
+        capacity = N;
+        return Storage::inlineData();
+    }
+
+    /**
+     * @brief Does nothing, the inline storage is never freed
+     *
+     * @param block pointer to the block
+     * @param capacity amount of elements the block can hold
+     */
+    void deallocate(T* block, size_t capacity)
+    {
+        (void)block;
+        (void)capacity;
+    }
+
+    /**
+     * @brief The elements are never on the heap, so they are always moved one by one
+     *
+     * @param block pointer to the block
+     * @return false the block is the inline storage
+     */
+    bool isOnHeap(const T* block) const
+    {
+        (void)block;
+        return false;
+    }
+};
+
+} // namespace aex
+
+#endif // _INCLUDE_AEX_STATIC_VECTOR_H_
@@ -10,235 +10,263 @@
  */
  
 #ifndef _INCLUDE_AEX_VECTOR_H_
-#define _INCULDE_AEX_VECTOR_H_
+#define _INCLUDE_AEX_VECTOR_H_
  
 #include "utils.h"
-#include <new> 
+#include "VectorBase.h"
+#include "Allocator.h"
+#include <new>
+#include <stdint.h> 
 
 namespace aex
 {
  
 /**
- * @brief STL-like vector class
+ * @brief Growth policy doubling the capacity of the vector (default)
  * 
- * @tparam T type of data contained in the array
+ * Fewest reallocations, but up to half of the allocated memory can be unused.
  */
-template<typename T>
-class Vector
+struct GrowthDouble
 {
-public:
     /**
-     * @brief Initialize an empty vector
+     * @brief Get the new capacity of a full vector
      * 
+     * @param capacity current capacity of the vector
+     * @return size_t new capacity of the vector
      */
-    Vector()
+    static size_t grow(size_t capacity)
     {
+        return (capacity > 0) ? capacity * 2 : 1;
     }
-
+};
+ 
+/**
+ * @brief Growth policy increasing the capacity of the vector by 50%
+ * 
+ * More reallocations than GrowthDouble, but less unused memory.
+ */
+struct GrowthOneAndHalf
+{
     /**
-     * @brief Initialize an empty vector with a given capacity
+     * @brief Get the new capacity of a full vector
      * 
-     * @param initialCapacity intial capacity of the vector
+     * @param capacity current capacity of the vector
+     * @return size_t new capacity of the vector
      */
-    Vector(size_t initialCapacity)
+    static size_t grow(size_t capacity)
     {
-        reAllocate(initialCapacity);
+        return (capacity > 1) ? capacity + capacity / 2 : capacity + 1;
     }
+};
  
+/**
+ * @brief Growth policy increasing the capacity of the vector by a fixed amount of elements
+ * 
+ * @tparam Increment amount of elements added to the capacity every time the vector is full
+ */
+template<size_t Increment>
+struct GrowthFixed
+{
+    static_assert(Increment > 0, "GrowthFixed needs an increment of at least one element");
+
     /**
-     * @brief Empty the vector and free memory
+     * @brief Get the new capacity of a full vector
      * 
+     * @param capacity current capacity of the vector
+     * @return size_t new capacity of the vector
      */
-    ~Vector()
+    static size_t grow(size_t capacity)
     {
-        // prevent deletion of an empty/uninitialized vector
-        if (m_data == nullptr)
-        {
-            return;
-        }
-
-        clear();
-        ::operator delete(m_data, m_capacity * sizeof(T));
+        return capacity + Increment;
     }
+};
  
+/**
+ * @brief Growth policy preventing the vector from growing on its own
+ * 
+ * Use reserve() (or the capacity constructor) during setup() to guarantee no memory is allocated
+ * afterwards. Adding an element to a full vector fails instead (pushBack() returns false and
+ * emplaceBack() returns nullptr), the existing elements are left untouched.
+ * 
+ * Note: a vector that was never given a capacity never allocates either, so inserting into it
+ * fails until reserve() is called.
+ */
+struct GrowthNever
+{
     /**
-     * @brief Add an element to the back of the vector
+     * @brief Get the new capacity of a full vector
      * 
-     * @param value new element (to be copied)
+     * @param capacity current capacity of the vector
+     * @return size_t new capacity of the vector (always unchanged)
      */
-    void pushBack(const T& value)
+    static size_t grow(size_t capacity)
     {
-        // copy data and increase the size
-        emplaceBack(value);
+        return capacity;
     }
+};
  
+/**
+ * @brief STL-like vector class
+ * 
+ * @tparam T type of data contained in the array
+ * @tparam GrowthPolicy how the capacity increases when the vector is full (GrowthDouble,
+ * GrowthOneAndHalf, GrowthFixed<N> or GrowthNever)
+ * @tparam Allocator where the elements are allocated (see Allocator.h)
+ * @tparam SizeType unsigned integer type storing the size and capacity (see CompactVector)
+ * 
+ * If the allocator runs out of memory, the vector behaves as if it was not allowed to grow.
+ */
+template<typename T, typename GrowthPolicy = GrowthDouble, typename Allocator = HeapAllocator, typename SizeType = size_t>
+class Vector : public priv::VectorBase<T, GrowthPolicy, Vector<T, GrowthPolicy, Allocator, SizeType>, SizeType>
+{
+    typedef priv::VectorBase<T, GrowthPolicy, Vector, SizeType> Base;
+ 
+public:
     /**
-     * @brief Add an element to the back of the vector
-     * 
-     * @param value rvalue reference to the new element
+     * @brief Initialize an empty vector
      * 
-     * This is useful when creating a new object directly in the vector
-     * (avoids copying the object around and allocating extra memory)
      */
-    void pushBack(T&& value)
+    Vector()
+    : Base(nullptr, 0)
     {
-        // copy data and increase the size
-        emplaceBack(move(value));
     }
- 
+
     /**
-     * @brief Constructs an element and adds it to the array
+     * @brief Initialize an empty vector with a given capacity
      * 
-     * @tparam Args types of the arguments to pass to the constructor (no need to manually type)
-     * @param args arguments to pass to the constructor
-     * @return T& reference to the new object
+     * @param initialCapacity intial capacity of the vector
      */
-    template<typename... Args>
-    T& emplaceBack(Args&&... args)
+    Vector(size_t initialCapacity)
+    : Base(nullptr, 0)
     {
-        if (m_size >= m_capacity)
-        {
-            reAllocate(m_capacity + max(m_capacity, 1));
-        }
- 
-        // add the data
-        new(&m_data[m_size]) T(forward<Args>(args)...); // create in place
-        return m_data[m_size++];
+        this->reserve(initialCapacity);
     }
- 
+
     /**
-     * @brief Remove the last element from the vector
+     * @brief Initialize a vector by copying another
      * 
+     * @param other vector to copy
      */
-    void popBack()
+    Vector(const Vector& other)
+    : Base(nullptr, 0)
     {
-        if (m_size > 0)
-        {
-            m_size--;
-            m_data[m_size].~T();
-        }
+        this->copyFrom(other);
     }
- 
+
     /**
-     * @brief Empty the vector
+     * @brief Initialize a vector by taking the memory of another
      * 
+     * @param other vector to move (left empty)
      */
-    void clear()
+    Vector(Vector&& other)
+    : Base(nullptr, 0)
     {
-        for (size_t i = 0; i < m_size; i++)
-        {
-            m_data[i].~T();
-        }
- 
-        m_size = 0;
+        this->moveFrom(other);
     }
- 
+
     /**
-     * @brief Access data contained in the vector
+     * @brief Copy the elements of another vector
      * 
-     * @param index index of where the data is stored
-     * @return const T& const reference to the data
+     * @param other vector to copy
+     * @return Vector& reference to this vector
      */
-    const T& operator[](size_t index) const
+    Vector& operator=(const Vector& other)
     {
-        if (index >= m_size)
+        if (this != &other)
         {
-            // error
+            this->copyFrom(other);
         }
- 
-        return m_data[index];
+
+        return *this;
     }
- 
+
     /**
-     * @brief Access data contained in the vector
-     * 
-     * @param index index of where the data is stored
-     * @return T& reference to the data
+     * @brief Take the memory of another vector
      * 
-     * This version of the [] operator allows you to modify the value
+     * @param other vector to move (left empty)
+     * @return Vector& reference to this vector
      */
-    T& operator[](size_t index)
+    Vector& operator=(Vector&& other)
     {
-        if (index >= m_size)
+        if (this != &other)
         {
-            // error
+            this->moveFrom(other);
         }
- 
-        return m_data[index];
+
+        return *this;
     }
  
     /**
-     * @brief Get the amount of element stored in the vector
+     * @brief Empty the vector and free memory
      * 
-     * @return size_t size of the vector
      */
-    size_t getSize() const
+    ~Vector()
     {
-        return m_size;
+        this->release();
     }
 
+private:
+    friend Base; // for the memory management functions
+
     /**
-     * @brief Get the current capacity of the vector
+     * @brief Allocate a block of memory with the allocator
      * 
-     * @return size_t amount of elements that can be stored without needing to reallocate
+     * @param capacity amount of elements the block must hold
+     * @return T* pointer to the block (nullptr for a capacity of zero or if out of memory)
      */
-    size_t getCapacity() const
+    T* allocate(size_t& capacity)
     {
-        return m_capacity;
+        if (capacity == 0)
+        {
+            return nullptr;
+        }
+
+        return static_cast<T*>(Allocator::allocate(capacity * sizeof(T)));
     }
- 
+
     /**
-     * @brief Check if the vector is empty
+     * @brief Free a block of memory allocated by allocate()
      * 
-     * @return true vector is empty
-     * @return false vector is not empty
+     * @param block pointer to the block (nothing is done for nullptr)
+     * @param capacity amount of elements the block can hold
      */
-    const bool isEmpty() const
+    void deallocate(T* block, size_t capacity)
     {
-        return (m_size == 0);
+        // prevent deletion of an empty/uninitialized vector
+        if (block == nullptr)
+        {
+            return;
+        }
+
+        Allocator::deallocate(block, capacity * sizeof(T));
     }
- 
-private:
+
     /**
-     * @brief Re-allocate a new block of memory and move all current elements
+     * @brief Check if a block of memory was allocated (and can be transferred to another vector)
      * 
-     * @param newCapacity size of array to allocate
+     * @param block pointer to the block
+     * @return true the block was allocated
+     * @return false there is no block
      */
-    void reAllocate(size_t newCapacity)
+    bool isOnHeap(const T* block) const
     {
-        // allocate new block of memory
-        T* newBlock = (T*)::operator new(newCapacity * sizeof(T));
- 
-        if (newCapacity < m_size)
-        {
-            m_size = newCapacity;
-            // warning
-        }
- 
-        // move old elements
-        for (size_t i = 0; i < m_size; i++)
-        {
-            new(&newBlock[i]) T(move(m_data[i])); // create in place
-        }
- 
-        for (size_t i = 0; i < m_size; i++)
-        {
-            m_data[i].~T();
-        }
- 
-        // delete old elements
-        ::operator delete(m_data, m_capacity * sizeof(T));
-        m_data     = newBlock;
-        m_capacity = newCapacity;
+        return (block != nullptr);
     }
- 
-private:
-    T* m_data = nullptr;   ///< pointer to the heap-allocated array
- 
-    size_t m_size     = 0; ///< number of elements in the vector
-    size_t m_capacity = 0; ///< max amount of elements the vector can store with currently allocated memory
 };
  
+/**
+ * @brief Vector storing its size and capacity in 16 bits (at most 65535 elements)
+ * 
+ * @tparam T type of data contained in the array
+ * @tparam GrowthPolicy how the capacity increases when the vector is full
+ * @tparam Allocator where the elements are allocated (see Allocator.h)
+ * 
+ * Same interface as Vector, but takes 8 bytes instead of 12 on 32-bit boards, which adds up in
+ * structs holding many small vectors. On AVR, size_t is already 16 bits so both are the same.
+ */
+template<typename T, typename GrowthPolicy = GrowthDouble, typename Allocator = HeapAllocator>
+using CompactVector = Vector<T, GrowthPolicy, Allocator, uint16_t>;
+ 
 } // namespace aex
  
 #endif // _INCLUDE_AEX_VECTOR_H_
\ No newline at end of file
@@ -0,0 +1,715 @@
+/**
+ * @file VectorBase.h
+ * @author Eliot Fondere
+ * @brief Element management shared by the vector containers
+ * 
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ * 
+ */
+ 
+#ifndef _INCLUDE_AEX_VECTOR_BASE_H_
+#define _INCLUDE_AEX_VECTOR_BASE_H_
+ 
+#include "utils.h"
+#include "Memory.h"
+#include "BoundsCheck.h"
+#include <new>
+
+namespace aex
+{
+
+namespace priv
+{
+ 
+/**
+ * @brief Common implementation of Vector and SmallVector
+ * 
+ * @tparam T type of data contained in the vector
+ * @tparam GrowthPolicy how the capacity increases when the vector is full
+ * @tparam Derived vector class inheriting from this one
+ * @tparam SizeType unsigned integer type storing the size and capacity (limits the capacity to
+ * its maximum value, e.g. uint16_t makes the vector smaller on 32-bit boards)
+ * 
+ * The derived class only decides where the memory comes from by implementing:
+ * - T* allocate(size_t& capacity): get a block for (at least) capacity elements, capacity can be
+ *   increased to the real capacity of the block (nullptr if out of memory)
+ * - void deallocate(T* block, size_t capacity): free a block returned by allocate()
+ * - bool isOnHeap(const T* block) const: check if a block can be transferred to another vector
+ */
+template<typename T, typename GrowthPolicy, typename Derived, typename SizeType = size_t>
+class VectorBase
+{
+public:
+    static_assert(static_cast<SizeType>(-1) > static_cast<SizeType>(0), "the size type of a vector must be unsigned");
+ 
+    /**
+     * @brief Add an element to the back of the vector
+     * 
+     * @param value new element (to be copied)
+     * @return true the element was added
+     * @return false the vector is full and not allowed to grow (or out of memory), nothing was added
+     */
+    bool pushBack(const T& value)
+    {
+        // copy data and increase the size
+        return (emplaceBack(value) != nullptr);
+    }
+ 
+    /**
+     * @brief Add an element to the back of the vector
+     * 
+     * @param value rvalue reference to the new element
+     * @return true the element was added
+     * @return false the vector is full and not allowed to grow (or out of memory), nothing was added
+     * 
+     * This is useful when creating a new object directly in the vector
+     * (avoids copying the object around and allocating extra memory)
+     */
+    bool pushBack(T&& value)
+    {
+        // copy data and increase the size
+        return (emplaceBack(move(value)) != nullptr);
+    }
+ 
+    /**
+     * @brief Constructs an element and adds it to the array
+     * 
+     * @tparam Args types of the arguments to pass to the constructor (no need to manually type)
+     * @param args arguments to pass to the constructor
+     * @return T* pointer to the new object, nullptr if the vector is full and not allowed to grow
+     * (or out of memory), in which case nothing is constructed
+     */
+    template<typename... Args>
+    T* emplaceBack(Args&&... args)
+    {
+        if (!ensureCapacity(m_size + 1))
+        {
+            // error: the vector is full and not allowed to grow, refuse the new element
+            return nullptr;
+        }
+ 
+        // add the data
+        new(&m_data[m_size]) T(forward<Args>(args)...); // create in place
+        return &m_data[m_size++];
+    }
+ 
+    /**
+     * @brief Copy a range of elements to the back of the vector
+     * 
+     * @param first pointer to the first element to copy
+     * @param count number of elements to copy
+     * 
+     * The vector grows at most once and the elements are copied in bulk (a single memcpy for
+     * trivially copyable types). If the vector is not allowed to grow enough, only the elements
+     * that fit are copied.
+     * Note: the elements to copy must not be inside the vector itself
+     */
+    void append(const T* first, size_t count)
+    {
+        if (!ensureCapacity(m_size + count))
+        {
+            // error: the vector is not allowed to grow enough, only copy what fits
+            count = m_capacity - m_size;
+        }
+
+        priv::copyRange(&m_data[m_size], first, count);
+        m_size += count;
+    }
+ 
+    /**
+     * @brief Replace the content of the vector with a copy of a range of elements
+     * 
+     * @param first pointer to the first element to copy
+     * @param count number of elements to copy
+     * 
+     * Note: the elements to copy must not be inside the vector itself
+     */
+    void assign(const T* first, size_t count)
+    {
+        clear();
+        append(first, count);
+    }
+ 
+    /**
+     * @brief Replace the content of the vector with copies of a value
+     * 
+     * @param count number of copies
+     * @param value value to copy (must not be an element of the vector)
+     */
+    void assign(size_t count, const T& value)
+    {
+        clear();
+        resize(count, value);
+    }
+ 
+    /**
+     * @brief Change the number of elements in the vector
+     * 
+     * @param newSize new number of elements
+     * 
+     * Extra elements are destroyed, new elements are default constructed. The vector grows at
+     * most once.
+     */
+    void resize(size_t newSize)
+    {
+        if (newSize <= m_size)
+        {
+            priv::destroyRange(&m_data[newSize], m_size - newSize);
+            m_size = newSize;
+            return;
+        }
+
+        if (!ensureCapacity(newSize))
+        {
+            // error: the vector is not allowed to grow enough, only fill what fits
+            newSize = m_capacity;
+        }
+
+        priv::constructRange(&m_data[m_size], newSize - m_size);
+        m_size = newSize;
+    }
+ 
+    /**
+     * @brief Change the number of elements in the vector
+     * 
+     * @param newSize new number of elements
+     * @param value value copied into the new elements (must not be an element of the vector)
+     * 
+     * Extra elements are destroyed, new elements are copies of value. The vector grows at most
+     * once.
+     */
+    void resize(size_t newSize, const T& value)
+    {
+        if (newSize <= m_size)
+        {
+            priv::destroyRange(&m_data[newSize], m_size - newSize);
+            m_size = newSize;
+            return;
+        }
+
+        if (!ensureCapacity(newSize))
+        {
+            // error: the vector is not allowed to grow enough, only fill what fits
+            newSize = m_capacity;
+        }
+
+        priv::fillRange(&m_data[m_size], newSize - m_size, value);
+        m_size = newSize;
+    }
+ 
+    /**
+     * @brief Remove the last element from the vector
+     * 
+     */
+    void popBack()
+    {
+        if (m_size > 0)
+        {
+            m_size--;
+            m_data[m_size].~T();
+        }
+    }
+ 
+    /**
+     * @brief Constructs an element at a given position, shifting the following elements back
+     * 
+     * @tparam Args types of the arguments to pass to the constructor (no need to manually type)
+     * @param index position of the new element (limited to the size of the vector)
+     * @param args arguments to pass to the constructor (must not refer to elements of the vector)
+     * @return T* pointer to the new object, nullptr if the vector is full and not allowed to grow
+     * (or out of memory), in which case the vector is left unchanged
+     */
+    template<typename... Args>
+    T* emplace(size_t index, Args&&... args)
+    {
+        if (!ensureCapacity(m_size + 1))
+        {
+            // error: the vector is full and not allowed to grow, refuse the new element
+            return nullptr;
+        }
+
+        if (index > m_size)
+        {
+            // error: index out of bounds, add to the back
+            index = m_size;
+        }
+
+        // make room for the new element (a single memmove for trivially relocatable types)
+        priv::relocateOverlapping(&m_data[index + 1], &m_data[index], m_size - index);
+        new(&m_data[index]) T(forward<Args>(args)...); // create in place
+        m_size++;
+        return &m_data[index];
+    }
+ 
+    /**
+     * @brief Add an element at a given position, shifting the following elements back
+     * 
+     * @param index position of the new element (limited to the size of the vector)
+     * @param value new element (to be copied, must not be an element of the vector)
+     * @return T* pointer to the new element, nullptr if the vector is full (see emplace())
+     */
+    T* insert(size_t index, const T& value)
+    {
+        return emplace(index, value);
+    }
+ 
+    /**
+     * @brief Add an element at a given position, shifting the following elements back
+     * 
+     * @param index position of the new element (limited to the size of the vector)
+     * @param value rvalue reference to the new element (must not be an element of the vector)
+     * @return T* pointer to the new element, nullptr if the vector is full (see emplace())
+     */
+    T* insert(size_t index, T&& value)
+    {
+        return emplace(index, move(value));
+    }
+ 
+    /**
+     * @brief Remove an element, shifting the following elements forward (keeps the order)
+     * 
+     * @param index position of the element to remove (nothing is done if out of bounds)
+     */
+    void erase(size_t index)
+    {
+        erase(index, index + 1);
+    }
+ 
+    /**
+     * @brief Remove a range of elements, shifting the following elements forward (keeps the order)
+     * 
+     * @param first position of the first element to remove
+     * @param last position past the last element to remove (limited to the size of the vector)
+     */
+    void erase(size_t first, size_t last)
+    {
+        if (last > m_size)
+        {
+            last = m_size;
+        }
+
+        if (first >= last)
+        {
+            return;
+        }
+
+        priv::destroyRange(&m_data[first], last - first);
+
+        // close the gap (a single memmove for trivially relocatable types)
+        priv::relocateOverlapping(&m_data[first], &m_data[last], m_size - last);
+        m_size -= last - first;
+    }
+ 
+    /**
+     * @brief Remove an element in O(1) by replacing it with the last element (changes the order)
+     * 
+     * @param index position of the element to remove (nothing is done if out of bounds)
+     */
+    void swapRemove(size_t index)
+    {
+        if (index >= m_size)
+        {
+            return;
+        }
+
+        if (index != m_size - 1)
+        {
+            m_data[index] = move(m_data[m_size - 1]);
+        }
+
+        popBack();
+    }
+ 
+    /**
+     * @brief Remove all the elements satisfying a condition in a single pass (keeps the order)
+     * 
+     * @tparam Predicate type of the condition (no need to manually type)
+     * @param predicate function called with every element (const T&), returns true to remove it
+     * @return size_t amount of elements removed
+     */
+    template<typename Predicate>
+    size_t eraseIf(Predicate predicate)
+    {
+        size_t kept = 0;
+
+        for (size_t i = 0; i < m_size; i++)
+        {
+            if (predicate(static_cast<const T&>(m_data[i])))
+            {
+                continue;
+            }
+
+            if (kept != i)
+            {
+                m_data[kept] = move(m_data[i]);
+            }
+
+            kept++;
+        }
+
+        size_t removed = m_size - kept;
+        priv::destroyRange(&m_data[kept], removed);
+        m_size = kept;
+        return removed;
+    }
+ 
+    /**
+     * @brief Empty the vector
+     * 
+     */
+    void clear()
+    {
+        // no destructor loop for trivially destructible types
+        priv::destroyRange(m_data, m_size);
+        m_size = 0;
+    }
+ 
+    /**
+     * @brief Make sure the vector can hold a given amount of elements without reallocating
+     * 
+     * @param newCapacity minimum capacity of the vector
+     * 
+     * Does nothing if the capacity is already large enough. Useful to allocate all the memory
+     * once in setup() so no allocation happens in loop().
+     */
+    void reserve(size_t newCapacity)
+    {
+        if (newCapacity > getMaxCapacity())
+        {
+            // error: the size type cannot count that many elements, reserve as much as possible
+            newCapacity = getMaxCapacity();
+        }
+
+        if (newCapacity > m_capacity)
+        {
+            reAllocate(newCapacity);
+        }
+    }
+ 
+    /**
+     * @brief Reduce the capacity of the vector to its size to free unused memory
+     * 
+     */
+    void shrinkToFit()
+    {
+        if (m_capacity > m_size)
+        {
+            reAllocate(m_size);
+        }
+    }
+ 
+    /**
+     * @brief Access data contained in the vector
+     * 
+     * @param index index of where the data is stored
+     * @return const T& const reference to the data
+     * 
+     * Note: the index is checked according to AEX_BOUNDS_CHECK (see BoundsCheck.h)
+     */
+    const T& operator[](size_t index) const
+    {
+        return m_data[priv::checkIndex(index, m_size)];
+    }
+ 
+    /**
+     * @brief Access data contained in the vector
+     * 
+     * @param index index of where the data is stored
+     * @return T& reference to the data
+     * 
+     * This version of the [] operator allows you to modify the value
+     * Note: the index is checked according to AEX_BOUNDS_CHECK (see BoundsCheck.h)
+     */
+    T& operator[](size_t index)
+    {
+        return m_data[priv::checkIndex(index, m_size)];
+    }
+ 
+    /**
+     * @brief Get the amount of element stored in the vector
+     * 
+     * @return size_t size of the vector
+     */
+    size_t getSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Get the current capacity of the vector
+     * 
+     * @return size_t amount of elements that can be stored without needing to reallocate
+     */
+    size_t getCapacity() const
+    {
+        return m_capacity;
+    }
+ 
+    /**
+     * @brief Get the largest capacity the vector can have
+     * 
+     * @return size_t maximum value of the size type
+     */
+    static constexpr size_t getMaxCapacity()
+    {
+        return static_cast<SizeType>(-1);
+    }
+ 
+    /**
+     * @brief Check if the vector is empty
+     * 
+     * @return true vector is empty
+     * @return false vector is not empty
+     */
+    const bool isEmpty() const
+    {
+        return (m_size == 0);
+    }
+ 
+    /**
+     * @brief Get a pointer to the elements of the vector
+     * 
+     * @return T* pointer to the first element
+     */
+    T* data()
+    {
+        return m_data;
+    }
+ 
+    /**
+     * @brief Get a pointer to the elements of the vector
+     * 
+     * @return const T* pointer to the first element (read only)
+     */
+    const T* data() const
+    {
+        return m_data;
+    }
+ 
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     * 
+     * @return T* pointer to the first element
+     */
+    T* begin()
+    {
+        return m_data;
+    }
+ 
+    /**
+     * @brief Get an iterator to the first element (allows range-based for loops)
+     * 
+     * @return const T* pointer to the first element (read only)
+     */
+    const T* begin() const
+    {
+        return m_data;
+    }
+ 
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     * 
+     * @return T* pointer past the last element
+     */
+    T* end()
+    {
+        return m_data + m_size;
+    }
+ 
+    /**
+     * @brief Get an iterator past the last element (allows range-based for loops)
+     * 
+     * @return const T* pointer past the last element (read only)
+     */
+    const T* end() const
+    {
+        return m_data + m_size;
+    }
+ 
+protected:
+    /**
+     * @brief Initialize the vector with a block of memory given by the derived class
+     * 
+     * @param data block of memory for the elements (can be nullptr if capacity is zero)
+     * @param capacity amount of elements the block of memory can hold
+     */
+    VectorBase(T* data, size_t capacity)
+    : m_data(data), m_capacity(capacity)
+    {
+    }
+
+    VectorBase(const VectorBase&) = delete;            ///< copying is implemented by the derived class
+    VectorBase& operator=(const VectorBase&) = delete; ///< copying is implemented by the derived class
+
+    /**
+     * @brief Replace the content of the vector with a copy of the elements of another
+     * 
+     * @param other vector to copy
+     */
+    void copyFrom(const VectorBase& other)
+    {
+        clear();
+        reserve(other.m_size);
+        append(other.m_data, other.m_size);
+    }
+
+    /**
+     * @brief Replace the content of the vector with the elements of another, leaving it empty
+     * 
+     * @param other vector to move
+     * 
+     * Heap-allocated elements are transferred by stealing the pointer, elements stored in the
+     * derived class itself (e.g. SmallVector) are moved one by one. If this vector cannot get
+     * enough memory for them, it is left empty and the other vector keeps its elements.
+     */
+    void moveFrom(Derived& other)
+    {
+        clear();
+        VectorBase& otherBase = other;
+
+        if (other.isOnHeap(otherBase.m_data))
+        {
+            derived().deallocate(m_data, m_capacity);
+            m_data     = otherBase.m_data;
+            m_size     = otherBase.m_size;
+            m_capacity = otherBase.m_capacity;
+
+            // give the other vector back its initial block of memory
+            size_t initialCapacity = 0;
+            otherBase.m_data     = other.allocate(initialCapacity);
+            otherBase.m_capacity = initialCapacity;
+            otherBase.m_size     = 0;
+        }
+        else
+        {
+            reserve(otherBase.m_size);
+
+            if (m_capacity < otherBase.m_size)
+            {
+                // error: out of memory (or the size type is too small), leave the other vector as is
+                return;
+            }
+
+            priv::relocateRange(m_data, otherBase.m_data, otherBase.m_size);
+            m_size           = otherBase.m_size;
+            otherBase.m_size = 0;
+        }
+    }
+
+    /**
+     * @brief Destroy all elements and free the memory (used by the destructor of the derived class)
+     * 
+     */
+    void release()
+    {
+        clear();
+        derived().deallocate(m_data, m_capacity);
+        m_data     = nullptr;
+        m_capacity = 0;
+    }
+
+private:
+    /**
+     * @brief Get the derived class (for the memory management functions)
+     * 
+     * @return Derived& reference to the derived vector
+     */
+    Derived& derived()
+    {
+        return static_cast<Derived&>(*this);
+    }
+
+    /**
+     * @brief Grow the vector (according to the growth policy) if it cannot hold a given amount of
+     * elements
+     * 
+     * @param required amount of elements the vector needs to hold
+     * @return true the vector can hold the required amount of elements
+     * @return false the growth policy does not allow the vector to grow (or out of memory)
+     * 
+     * The vector is reallocated at most once, to the larger of the required amount and the
+     * capacity given by the growth policy.
+     */
+    bool ensureCapacity(size_t required)
+    {
+        if (required <= m_capacity)
+        {
+            return true;
+        }
+
+        if (required > getMaxCapacity())
+        {
+            // the size type cannot count that many elements
+            return false;
+        }
+
+        size_t newCapacity = GrowthPolicy::grow(m_capacity);
+
+        if (newCapacity > getMaxCapacity())
+        {
+            newCapacity = getMaxCapacity();
+        }
+
+        if (newCapacity <= m_capacity)
+        {
+            return false;
+        }
+
+        return reAllocate((newCapacity > required) ? newCapacity : required);
+    }
+ 
+    /**
+     * @brief Re-allocate a new block of memory and move all current elements
+     * 
+     * @param newCapacity size of array to allocate
+     * @return true the elements are in the new block of memory
+     * @return false the allocation failed, the vector is left unchanged
+     */
+    bool reAllocate(size_t newCapacity)
+    {
+        // allocate new block of memory (the derived class can round up the capacity)
+        T* newBlock = derived().allocate(newCapacity);
+
+        if (newBlock == nullptr && newCapacity > 0)
+        {
+            // error: out of memory, keep the current block (checked first, an empty vector has
+            // no block either)
+            return false;
+        }
+
+        if (newBlock == m_data)
+        {
+            // the derived class gave back the current block, nothing to move
+            return true;
+        }
+ 
+        if (newCapacity < m_size)
+        {
+            priv::destroyRange(&m_data[newCapacity], m_size - newCapacity);
+            m_size = newCapacity;
+            // warning
+        }
+ 
+        // move old elements (a single memcpy for trivially relocatable types)
+        priv::relocateRange(newBlock, m_data, m_size);
+ 
+        // delete old elements
+        derived().deallocate(m_data, m_capacity);
+
+        m_data     = newBlock;
+        m_capacity = newCapacity;
+        return true;
+    }
+ 
+protected:
+    T* m_data = nullptr;   ///< pointer to the array of elements
+ 
+    SizeType m_size     = 0; ///< number of elements in the vector
+    SizeType m_capacity = 0; ///< max amount of elements the vector can store with currently allocated memory
+};
+
+} // namespace priv
+ 
+} // namespace aex
+ 
+#endif // _INCLUDE_AEX_VECTOR_BASE_H_
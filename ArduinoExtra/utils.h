@@ -14,6 +14,16 @@
 #ifndef _INCLUDE_AEX_UTILS_H_
 #define _INCLUDE_AEX_UTILS_H_
  
+/**
+ * @brief constexpr for functions that can only be constexpr since C++14 (loops, non-const
+ * methods, etc.), expands to nothing in C++11
+ */
+#if __cplusplus >= 201402L
+#define AEX_CONSTEXPR14 constexpr
+#else
+#define AEX_CONSTEXPR14
+#endif
+ 
 namespace aex
 {
  
@@ -54,6 +64,206 @@ struct remove_reference<T&&>
     typedef T type;
 };
  
+/**
+ * @brief Return a type without its const qualifier
+ * 
+ * @tparam T type (with or without const)
+ */
+template<typename T>
+struct remove_const
+{
+    typedef T type;
+};
+ 
+/**
+ * @brief Template specialization for const types
+ * 
+ * @tparam T const type
+ * 
+ * @see remove_const
+ */
+template<typename T>
+struct remove_const<const T>
+{
+    typedef T type;
+};
+ 
+/**
+ * @brief Check if two types are the same
+ * 
+ * @tparam T first type
+ * @tparam U second type
+ */
+template<typename T, typename U>
+struct is_same
+{
+    static constexpr bool value = false;
+};
+ 
+/**
+ * @brief Template specialization for identical types
+ * 
+ * @tparam T type
+ * 
+ * @see is_same
+ */
+template<typename T>
+struct is_same<T, T>
+{
+    static constexpr bool value = true;
+};
+ 
+/**
+ * @brief Only define a type if a condition is true (used to disable template overloads)
+ * 
+ * @tparam Condition condition to check at compile time
+ * @tparam T type defined if the condition is true
+ */
+template<bool Condition, typename T = void>
+struct enable_if
+{
+};
+ 
+/**
+ * @brief Template specialization for a true condition
+ * 
+ * @tparam T type defined
+ * 
+ * @see enable_if
+ */
+template<typename T>
+struct enable_if<true, T>
+{
+    typedef T type;
+};
+ 
+/**
+ * @brief Choose between two types at compile time
+ * 
+ * @tparam Condition condition to check at compile time
+ * @tparam T type chosen if the condition is true
+ * @tparam F type chosen if the condition is false
+ */
+template<bool Condition, typename T, typename F>
+struct conditional
+{
+    typedef T type;
+};
+ 
+/**
+ * @brief Template specialization for a false condition
+ * 
+ * @tparam T type chosen if the condition is true
+ * @tparam F type chosen if the condition is false
+ * 
+ * @see conditional
+ */
+template<typename T, typename F>
+struct conditional<false, T, F>
+{
+    typedef F type;
+};
+ 
+/**
+ * @brief Check if a type can be copied with memcpy (no user-defined copy, move or destructor)
+ * 
+ * @tparam T type to check
+ */
+template<typename T>
+struct is_trivially_copyable
+{
+    static constexpr bool value = __is_trivially_copyable(T);
+};
+ 
+/**
+ * @brief Check if the destructor of a type does nothing
+ * 
+ * @tparam T type to check
+ */
+template<typename T>
+struct is_trivially_destructible
+{
+    static constexpr bool value = __has_trivial_destructor(T);
+};
+ 
+/**
+ * @brief Check if an object can be moved to another address with memcpy (without calling its
+ * move constructor and destructor)
+ * 
+ * @tparam T type to check
+ * 
+ * Trivially copyable types are always trivially relocatable. Specialize this struct for other
+ * types that do not keep pointers to themselves to allow containers to relocate them faster.
+ */
+template<typename T>
+struct is_trivially_relocatable
+{
+    static constexpr bool value = is_trivially_copyable<T>::value;
+};
+ 
+/**
+ * @brief Compile-time list of indices (used to expand a parameter pack over 0, 1, ..., N - 1)
+ * 
+ * @tparam I indices
+ */
+template<size_t... I>
+struct index_sequence
+{
+};
+ 
+namespace priv
+{
+ 
+/**
+ * @brief Join two index sequences, shifting the second one by the size of the first
+ * 
+ * @tparam A first sequence
+ * @tparam B second sequence
+ */
+template<typename A, typename B>
+struct concat_index_sequence;
+ 
+template<size_t... A, size_t... B>
+struct concat_index_sequence<index_sequence<A...>, index_sequence<B...>>
+{
+    typedef index_sequence<A..., (sizeof...(A) + B)...> type;
+};
+ 
+/**
+ * @brief Build the sequence 0, 1, ..., N - 1 by halves (so long sequences do not hit the template
+ * recursion limit)
+ * 
+ * @tparam N size of the sequence
+ */
+template<size_t N>
+struct make_index_sequence_impl
+{
+    typedef typename concat_index_sequence<typename make_index_sequence_impl<N / 2>::type,
+                                           typename make_index_sequence_impl<N - N / 2>::type>::type type;
+};
+ 
+template<>
+struct make_index_sequence_impl<0>
+{
+    typedef index_sequence<> type;
+};
+ 
+template<>
+struct make_index_sequence_impl<1>
+{
+    typedef index_sequence<0> type;
+};
+ 
+} // namespace priv
+ 
+/**
+ * @brief The index sequence 0, 1, ..., N - 1
+ * 
+ * @tparam N size of the sequence
+ */
+template<size_t N>
+using make_index_sequence = typename priv::make_index_sequence_impl<N>::type;
+ 
 /**
  * @brief Cast a variable to an rvalue
  * 
@@ -94,6 +304,21 @@ constexpr T&& forward(typename remove_reference<T>::type&& value) noexcept
     return static_cast<T&&>(value);
 }
  
+/**
+ * @brief Exchange the values of two variables (using move semantics)
+ * 
+ * @tparam T type of the variables
+ * @param a first variable
+ * @param b second variable
+ */
+template<typename T>
+inline void swap(T& a, T& b)
+{
+    T temporary(move(a));
+    a = move(b);
+    b = move(temporary);
+}
+ 
 } // namespace aex
  
 #endif // _INCLUDE_AEX_UTILS_H_
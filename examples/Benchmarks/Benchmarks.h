@@ -0,0 +1,303 @@
+/**
+ * @file Benchmarks.h
+ * @author Eliot Fondere
+ * @brief Benchmarks of the Vector, Array and Function hot paths, shared by the sketch and the host build
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Every benchmark prints the average time per operation in nanoseconds (with two decimals) and,
+ * when the clock speed is known (F_CPU on Arduino boards), in CPU cycles. On a board, timings come
+ * from micros(), so each benchmark repeats its operation enough times to hide the resolution of
+ * the timer (4 us on AVR). The host build provides a nanosecond clock instead (BENCH_HAS_NANOS).
+ *
+ * The results of the measured code are accumulated in a checksum printed at the end, so the
+ * compiler cannot remove the loops. The checksum only changes if the behavior of the library does.
+ *
+ * The memory section prints the size of the containers and, on AVR, the free SRAM before and after
+ * the benchmarks (a difference means memory was leaked). Flash usage is printed by the Arduino IDE
+ * when compiling (or by `size` on the host).
+ */
+
+#ifndef _INCLUDE_AEX_BENCHMARKS_H_
+#define _INCLUDE_AEX_BENCHMARKS_H_
+
+#include <ArduinoExtra.h>
+
+namespace bench
+{
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 2000UL ///< Number of repetitions of each operation
+#endif
+
+const size_t ELEMENTS = 64; ///< Number of elements pushed in the container benchmarks
+
+volatile unsigned long sink = 0; ///< Written by the benchmarks so the compiler cannot remove them (printed as the checksum)
+
+/**
+ * @brief Read the clock of the benchmarks
+ *
+ * @return unsigned long time in nanoseconds (wraps around, only differences are meaningful)
+ */
+inline unsigned long now()
+{
+#if defined(BENCH_HAS_NANOS)
+    return nanos();
+#else
+    return micros() * 1000UL;
+#endif
+}
+
+/**
+ * @brief Functions and methods called by the dispatch benchmarks
+ */
+void addFunction(int value)
+{
+    sink += static_cast<unsigned long>(value);
+}
+
+class Adder
+{
+public:
+    void add(int value)
+    {
+        sink += static_cast<unsigned long>(value);
+    }
+};
+
+#if defined(__AVR__)
+extern "C" char* __brkval;
+extern char __heap_start;
+
+/**
+ * @brief Get the amount of free SRAM between the heap and the stack
+ *
+ * @return int number of free bytes
+ */
+int getFreeMemory()
+{
+    char top;
+    return &top - (__brkval == nullptr ? &__heap_start : __brkval);
+}
+#endif
+
+/**
+ * @brief Print a quotient with two decimals (without floating point, which AVR prints poorly)
+ *
+ * @tparam P type of the printer (no need to manually type)
+ * @param printer where to print
+ * @param total dividend
+ * @param count divisor (not zero)
+ */
+template<typename P>
+void printFraction(P& printer, unsigned long long total, unsigned long count)
+{
+    unsigned long hundredths = static_cast<unsigned long>((total % count) * 100ULL / count);
+
+    printer.print(static_cast<unsigned long>(total / count));
+    printer.print(hundredths < 10 ? ".0" : ".");
+    printer.print(hundredths);
+}
+
+/**
+ * @brief Print the result of a benchmark
+ *
+ * @tparam P type of the printer (no need to manually type)
+ * @param printer where to print (e.g. Serial)
+ * @param name name of the benchmark
+ * @param elapsed total time in nanoseconds
+ * @param operations number of operations measured
+ */
+template<typename P>
+void report(P& printer, const char* name, unsigned long elapsed, unsigned long operations)
+{
+    printer.print(name);
+    printer.print("\t");
+    printFraction(printer, elapsed, operations);
+    printer.print(" ns");
+
+#if defined(F_CPU)
+    printer.print("\t");
+    printFraction(printer, static_cast<unsigned long long>(elapsed) * (F_CPU / 1000000UL) / 1000UL, operations);
+    printer.print(" cycles");
+#endif
+
+    printer.println();
+}
+
+/**
+ * @brief Measure the time taken by some code repeated BENCH_ITERATIONS times
+ *
+ * @tparam F type of the code to measure (no need to manually type)
+ * @param code function called at every iteration
+ * @return unsigned long total time in nanoseconds
+ */
+template<typename F>
+unsigned long measure(F code)
+{
+    unsigned long start = now();
+
+    for (unsigned long i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        code();
+    }
+
+    return now() - start;
+}
+
+/**
+ * @brief Fill a container with ELEMENTS integers, repeated BENCH_ITERATIONS / ELEMENTS times
+ *
+ * @tparam C type of the container
+ * @tparam P type of the printer
+ * @param printer where to print
+ * @param name name of the benchmark
+ * @param reserve reserve the capacity beforehand (so growth is not measured)
+ */
+template<typename C, typename P>
+void benchmarkPushBack(P& printer, const char* name, bool reserve)
+{
+    unsigned long repetitions = BENCH_ITERATIONS / ELEMENTS;
+    unsigned long start = now();
+
+    for (unsigned long r = 0; r < repetitions; r++)
+    {
+        C container;
+
+        if (reserve)
+        {
+            container.reserve(ELEMENTS);
+        }
+
+        for (size_t i = 0; i < ELEMENTS; i++)
+        {
+            container.pushBack(static_cast<int>(i));
+        }
+
+        sink += static_cast<unsigned long>(container[ELEMENTS - 1]);
+    }
+
+    report(printer, name, now() - start, repetitions * ELEMENTS);
+}
+
+/**
+ * @brief Run all the benchmarks
+ *
+ * @tparam P type of the printer (no need to manually type)
+ * @param printer where to print the results (e.g. Serial)
+ */
+template<typename P>
+void runAll(P& printer)
+{
+#if defined(__AVR__)
+    int freeBefore = getFreeMemory();
+#endif
+
+    printer.println("--- pushBack (per element) ---");
+    benchmarkPushBack<aex::Vector<int>>(printer, "Vector reserved", true);
+    benchmarkPushBack<aex::StaticVector<int, ELEMENTS>>(printer, "StaticVector", false);
+    benchmarkPushBack<aex::SmallVector<int, ELEMENTS>>(printer, "SmallVector inline", false);
+
+    printer.println("--- growth (per element, no reserve) ---");
+    benchmarkPushBack<aex::Vector<int, aex::GrowthDouble>>(printer, "GrowthDouble", false);
+    benchmarkPushBack<aex::Vector<int, aex::GrowthOneAndHalf>>(printer, "GrowthOneAndHalf", false);
+    benchmarkPushBack<aex::Vector<int, aex::GrowthFixed<8>>>(printer, "GrowthFixed<8>", false);
+    benchmarkPushBack<aex::SmallVector<int, 8>>(printer, "SmallVector spill", false);
+
+    printer.println("--- Array access (per element) ---");
+    {
+        aex::Array<int, ELEMENTS> array = {};
+        unsigned long elapsed = measure([&array]() -> void
+        {
+            for (size_t i = 0; i < ELEMENTS; i++)
+            {
+                array[i] += static_cast<int>(i);
+            }
+        });
+        sink += static_cast<unsigned long>(array[ELEMENTS - 1]);
+        report(printer, "Array operator[]", elapsed, BENCH_ITERATIONS * ELEMENTS);
+    }
+
+    printer.println("--- dispatch (per call) ---");
+    {
+        Adder adder;
+        void (*volatile functionPtr)(int) = &addFunction;
+        aex::Function<void(int)> function = &addFunction;
+        aex::Function<void(int)> boundMethod = aex::Function<void(int)>::bind<Adder, &Adder::add>(adder);
+        aex::Function<void(int)> methodPtr = aex::Function<void(int)>::bind(adder, &Adder::add);
+        auto lambda = [&adder](int value) -> void { adder.add(value); };
+        aex::Function<void(int)> lambdaFunction = lambda;
+        aex::FunctionRef<void(int)> functionRef = aex::FunctionRef<void(int)>::bind<Adder, &Adder::add>(adder);
+
+        report(printer, "direct call", measure([&adder]() -> void { adder.add(1); }), BENCH_ITERATIONS);
+        report(printer, "function pointer", measure([&functionPtr]() -> void { functionPtr(1); }), BENCH_ITERATIONS);
+        report(printer, "Function(function)", measure([&function]() -> void { function(1); }), BENCH_ITERATIONS);
+        report(printer, "Function::bind<&m>", measure([&boundMethod]() -> void { boundMethod(1); }), BENCH_ITERATIONS);
+        report(printer, "Function::bind(&m)", measure([&methodPtr]() -> void { methodPtr(1); }), BENCH_ITERATIONS);
+        report(printer, "Function(lambda)", measure([&lambdaFunction]() -> void { lambdaFunction(1); }), BENCH_ITERATIONS);
+        report(printer, "FunctionRef::bind", measure([&functionRef]() -> void { functionRef(1); }), BENCH_ITERATIONS);
+    }
+
+    printer.println("--- copy / move (per operation) ---");
+    {
+        aex::Vector<int> source(ELEMENTS);
+        source.resize(ELEMENTS, 1);
+
+        report(printer, "Vector copy", measure([&source]() -> void
+        {
+            aex::Vector<int> copy(source);
+            sink += static_cast<unsigned long>(copy[0]);
+        }), BENCH_ITERATIONS);
+
+        report(printer, "Vector move", measure([&source]() -> void
+        {
+            aex::Vector<int> moved(aex::move(source));
+            source = aex::move(moved);
+        }), BENCH_ITERATIONS);
+        sink += static_cast<unsigned long>(source.getSize());
+
+        Adder adder;
+        aex::Function<void(int)> function = aex::Function<void(int)>::bind<Adder, &Adder::add>(adder);
+
+        report(printer, "Function copy", measure([&function]() -> void
+        {
+            aex::Function<void(int)> copy(function);
+            copy(1);
+        }), BENCH_ITERATIONS);
+
+        report(printer, "Function move", measure([&function]() -> void
+        {
+            aex::Function<void(int)> moved(aex::move(function));
+            function = aex::move(moved);
+        }), BENCH_ITERATIONS);
+        function(1); // the moved function must still work
+    }
+
+    printer.println("--- memory (bytes) ---");
+    printer.print("sizeof(Vector<int>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::Vector<int>)));
+    printer.print("sizeof(CompactVector<int>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::CompactVector<int>)));
+    printer.print("sizeof(SmallVector<int, 8>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::SmallVector<int, 8>)));
+    printer.print("sizeof(StaticVector<int, 8>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::StaticVector<int, 8>)));
+    printer.print("sizeof(Function<void(int)>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::Function<void(int)>)));
+    printer.print("sizeof(FunctionRef<void(int)>)\t");
+    printer.println(static_cast<unsigned long>(sizeof(aex::FunctionRef<void(int)>)));
+
+    printer.print("checksum\t");
+    printer.println(static_cast<unsigned long>(sink));
+
+#if defined(__AVR__)
+    printer.print("free SRAM before\t");
+    printer.println(freeBefore);
+    printer.print("free SRAM after\t");
+    printer.println(getFreeMemory());
+#endif
+}
+
+} // namespace bench
+
+#endif // _INCLUDE_AEX_BENCHMARKS_H_
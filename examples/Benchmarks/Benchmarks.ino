@@ -0,0 +1,29 @@
+/**
+ * @file Benchmarks.ino
+ * @author Eliot Fondere
+ * @brief Measures the Vector, Array and Function hot paths on the board (results on Serial)
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Upload the sketch and open the Serial Monitor at 115200 baud. The same benchmarks can be run on
+ * a computer, see host/main.cpp.
+ */
+
+#include <ArduinoExtra.h>
+#include "Benchmarks.h"
+
+void setup()
+{
+    Serial.begin(115200);
+
+    while (!Serial)
+    {
+        // wait for the serial port on boards with native USB
+    }
+
+    bench::runAll(Serial);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,72 @@
+/**
+ * @file Arduino.h
+ * @author Eliot Fondere
+ * @brief Minimal stand-in for the Arduino core so the benchmarks can be compiled on a computer
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Only provides what the library and the benchmarks use.
+ */
+
+#ifndef _INCLUDE_AEX_HOST_ARDUINO_H_
+#define _INCLUDE_AEX_HOST_ARDUINO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+inline unsigned long micros()
+{
+    using namespace std::chrono;
+    return static_cast<unsigned long>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+/// the benchmarks time with nanos() instead of micros() (a computer has a much finer clock)
+#define BENCH_HAS_NANOS
+
+inline unsigned long nanos()
+{
+    using namespace std::chrono;
+    return static_cast<unsigned long>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline unsigned long millis()
+{
+    return micros() / 1000UL;
+}
+
+/**
+ * @brief Prints to the standard output like Serial
+ */
+class HostSerial
+{
+public:
+    void print(const char* text) { printf("%s", text); }
+    void print(int value) { printf("%d", value); }
+    void print(unsigned int value) { printf("%u", value); }
+    void print(long value) { printf("%ld", value); }
+    void print(unsigned long value) { printf("%lu", value); }
+    void print(double value) { printf("%.2f", value); }
+    void println() { printf("\n"); }
+
+    template<typename T>
+    void println(T value)
+    {
+        print(value);
+        println();
+    }
+};
+
+static HostSerial Serial;
+
+#endif // _INCLUDE_AEX_HOST_ARDUINO_H_
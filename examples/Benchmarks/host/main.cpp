@@ -0,0 +1,27 @@
+/**
+ * @file main.cpp
+ * @author Eliot Fondere
+ * @brief Runs the benchmarks of the Benchmarks sketch on a computer
+ *
+ * @copyright Copyright (c) 2023 Vanier Robotics (MIT License)
+ *
+ * Build and run from this folder (the library folder must be three levels up):
+ * @code
+ * g++ -std=gnu++11 -O2 -I. -I../../.. main.cpp -o benchmarks && ./benchmarks
+ * @endcode
+ *
+ * Compare results between two versions of the library on the same computer, the absolute numbers
+ * say little about the timings on a board.
+ */
+
+// a computer is much faster than a board, repeat more to get meaningful timings
+#define BENCH_ITERATIONS 200000UL
+
+#include "Arduino.h"
+#include "../Benchmarks.h"
+
+int main()
+{
+    bench::runAll(Serial);
+    return 0;
+}